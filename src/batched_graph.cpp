@@ -0,0 +1,207 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "batched_graph.hpp"
+
+// C++ includes
+#include <algorithm>
+
+namespace profiling {
+namespace graphs {
+
+namespace {
+
+[[nodiscard]] bool is_sorted(const lal::neighbourhood& l) noexcept
+{
+	return std::is_sorted(l.begin(), l.end());
+}
+
+} // namespace
+
+batched_graph::batched_graph(const lal::graphs::undirected_graph& g) noexcept
+	: m_directed(false),
+	  m_num_edges(g.get_num_edges())
+{
+	const uint64_t n = g.get_num_nodes();
+	m_out.resize(n);
+	m_dirty_out.resize(n);
+	for (lal::node u = 0; u < n; ++u) {
+		m_out[u] = g.get_neighbors(u);
+		m_dirty_out[u] = not is_sorted(m_out[u]);
+	}
+}
+
+batched_graph::batched_graph(const lal::graphs::directed_graph& g) noexcept
+	: m_directed(true),
+	  m_num_edges(g.get_num_edges())
+{
+	const uint64_t n = g.get_num_nodes();
+	m_out.resize(n);
+	m_dirty_out.resize(n);
+	m_in.resize(n);
+	m_dirty_in.resize(n);
+	for (lal::node u = 0; u < n; ++u) {
+		m_out[u] = g.get_out_neighbors(u);
+		m_dirty_out[u] = not is_sorted(m_out[u]);
+		m_in[u] = g.get_in_neighbors(u);
+		m_dirty_in[u] = not is_sorted(m_in[u]);
+	}
+}
+
+void batched_graph::add_edges(
+	const lal::edge_list& batch, const bool normalize
+) noexcept
+{
+	sort_batch(batch, false);
+	add_sorted(m_out, m_dirty_out, normalize);
+	if (m_directed) {
+		sort_batch(batch, true);
+		add_sorted(m_in, m_dirty_in, normalize);
+	}
+	m_num_edges += batch.size();
+}
+
+void batched_graph::remove_edges(const lal::edge_list& batch) noexcept
+{
+	sort_batch(batch, false);
+	remove_sorted(m_out, m_dirty_out);
+	if (m_directed) {
+		sort_batch(batch, true);
+		remove_sorted(m_in, m_dirty_in);
+	}
+	m_num_edges -= batch.size();
+}
+
+bool batched_graph::has_edge(const lal::node u, const lal::node v) noexcept
+{
+	lal::neighbourhood& l = m_out[u];
+	if (m_dirty_out[u]) {
+		std::sort(l.begin(), l.end());
+		m_dirty_out[u] = 0;
+	}
+	return std::binary_search(l.begin(), l.end(), v);
+}
+
+uint64_t batched_graph::get_num_dirty_lists() const noexcept
+{
+	return static_cast<uint64_t>(
+		std::count(m_dirty_out.begin(), m_dirty_out.end(), 1) +
+		std::count(m_dirty_in.begin(), m_dirty_in.end(), 1)
+	);
+}
+
+void batched_graph::sort_batch(
+	const lal::edge_list& batch, const bool reversed
+) noexcept
+{
+	m_batch.clear();
+	for (const auto& [u, v] : batch) {
+		if (reversed) {
+			m_batch.emplace_back(v, u);
+		}
+		else {
+			m_batch.emplace_back(u, v);
+		}
+		if (not m_directed) {
+			m_batch.emplace_back(v, u);
+		}
+	}
+	std::sort(m_batch.begin(), m_batch.end());
+}
+
+void batched_graph::add_sorted(
+	std::vector<lal::neighbourhood>& lists,
+	std::vector<char>& dirty,
+	const bool normalize
+) noexcept
+{
+	for (std::size_t i = 0; i < m_batch.size();) {
+		const lal::node u = m_batch[i].first;
+		lal::neighbourhood& l = lists[u];
+
+		// append the (sorted) neighbours of u in the batch
+		const std::size_t old_size = l.size();
+		for (; i < m_batch.size() and m_batch[i].first == u; ++i) {
+			l.push_back(m_batch[i].second);
+		}
+
+		const auto middle = l.begin() + static_cast<std::ptrdiff_t>(old_size);
+		if (dirty[u]) {
+			if (normalize) {
+				std::sort(l.begin(), l.end());
+				dirty[u] = 0;
+			}
+		}
+		else if (old_size > 0 and *middle < *(middle - 1)) {
+			if (normalize) {
+				std::inplace_merge(l.begin(), middle, l.end());
+			}
+			else {
+				dirty[u] = 1;
+			}
+		}
+	}
+}
+
+void batched_graph::remove_sorted(
+	std::vector<lal::neighbourhood>& lists, std::vector<char>& dirty
+) noexcept
+{
+	for (std::size_t i = 0; i < m_batch.size();) {
+		const lal::node u = m_batch[i].first;
+		lal::neighbourhood& l = lists[u];
+		if (dirty[u]) {
+			std::sort(l.begin(), l.end());
+			dirty[u] = 0;
+		}
+
+		// remove one occurrence of every neighbour of u in the batch, in a
+		// single pass over both sorted sequences
+		std::size_t j = i;
+		auto out = l.begin();
+		for (auto it = l.begin(); it != l.end(); ++it) {
+			while (j < m_batch.size() and m_batch[j].first == u and
+				   m_batch[j].second < *it) {
+				++j;
+			}
+			if (j < m_batch.size() and m_batch[j].first == u and
+				m_batch[j].second == *it) {
+				++j;
+				continue;
+			}
+			*out++ = *it;
+		}
+		l.erase(out, l.end());
+
+		while (i < m_batch.size() and m_batch[i].first == u) {
+			++i;
+		}
+	}
+}
+
+} // namespace graphs
+} // namespace profiling
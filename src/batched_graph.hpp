@@ -0,0 +1,114 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <vector>
+
+// lal includes
+#include <lal/basic_types.hpp>
+#include <lal/graphs/directed_graph.hpp>
+#include <lal/graphs/undirected_graph.hpp>
+
+namespace profiling {
+namespace graphs {
+
+/*
+ * Adjacency lists updated in batches.
+ *
+ * A batch of edges is sorted once, and the edges of every vertex are then
+ * merged into (or removed from) its list in time linear in the length of
+ * the list and of its part of the batch, instead of searching the list once
+ * per edge.
+ *
+ * Sorting the lists is deferred. Adding a batch without normalising appends
+ * the new neighbours and marks the lists that became unsorted as dirty. A
+ * dirty list is only sorted by the first operation that needs it sorted:
+ * removing edges from it, or has_edge.
+ */
+class batched_graph {
+public:
+
+	// Copies the lists of an undirected graph or a free tree.
+	explicit batched_graph(const lal::graphs::undirected_graph& g) noexcept;
+	// Copies the lists of a directed graph or a rooted tree.
+	explicit batched_graph(const lal::graphs::directed_graph& g) noexcept;
+
+	// Adds the edges in 'batch'. When 'normalize' is true, every list
+	// touched is left sorted.
+	void add_edges(const lal::edge_list& batch, const bool normalize) noexcept;
+
+	// Removes the edges in 'batch', which must be in the graph.
+	void remove_edges(const lal::edge_list& batch) noexcept;
+
+	// Whether the graph has the edge (u,v). Sorts the list of u if it is
+	// dirty.
+	[[nodiscard]] bool has_edge(const lal::node u, const lal::node v) noexcept;
+
+	[[nodiscard]] uint64_t get_num_edges() const noexcept
+	{
+		return m_num_edges;
+	}
+	[[nodiscard]] uint64_t get_num_dirty_lists() const noexcept;
+
+private:
+
+	// Fills 'm_batch' with the edges of 'batch' sorted by first vertex and
+	// then by second. With 'reversed', edges (u,v) are stored as (v,u).
+	// Edges of undirected graphs are stored in both directions.
+	void sort_batch(const lal::edge_list& batch, const bool reversed) noexcept;
+
+	// Adds the edges in 'm_batch' to 'lists'.
+	void add_sorted(
+		std::vector<lal::neighbourhood>& lists,
+		std::vector<char>& dirty,
+		const bool normalize
+	) noexcept;
+
+	// Removes the edges in 'm_batch' from 'lists'.
+	void remove_sorted(
+		std::vector<lal::neighbourhood>& lists, std::vector<char>& dirty
+	) noexcept;
+
+	const bool m_directed;
+	uint64_t m_num_edges;
+
+	// neighbours of undirected graphs, out-neighbours of directed graphs
+	std::vector<lal::neighbourhood> m_out;
+	std::vector<char> m_dirty_out;
+	// in-neighbours of directed graphs
+	std::vector<lal::neighbourhood> m_in;
+	std::vector<char> m_dirty_in;
+
+	// the batch being applied, sorted
+	lal::edge_list m_batch;
+};
+
+} // namespace graphs
+} // namespace profiling
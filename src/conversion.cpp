@@ -26,18 +26,23 @@
  ***********************************************************************/
 
 // C++ includes
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
 #include <string>
+#include <vector>
 
 // lal includes
 #include <lal/generate/rand_ulab_rooted_trees.hpp>
 #include <lal/linarr/C/C.hpp>
+#include <lal/graphs/directed_graph.hpp>
 #include <lal/graphs/free_tree.hpp>
 #include <lal/graphs/rooted_tree.hpp>
 
 // common includes
 #include "dir_to_undir_pp.hpp"
 #include "time.hpp"
+#include "undirected_view.hpp"
 
 namespace profiling {
 namespace dir_to_undir {
@@ -101,6 +106,148 @@ void rtree_to_ftree(
 	output_total_time(total_time, num_calls, n, T);
 }
 
+// Visits the neighbours of every vertex once. Returns the sum of (u + 1) * w
+// over all vertices u and all neighbours w of u, which does not depend on the
+// order of the neighbours. 'graph_t' is an undirected graph or an undirected
+// view.
+template <class graph_t>
+[[nodiscard]] uint64_t traverse(const graph_t& g) noexcept
+{
+	uint64_t sum = 0;
+	for (lal::node u = 0; u < g.get_num_nodes(); ++u) {
+		for (const lal::node w : g.get_neighbors(u)) {
+			sum += (u + 1) * w;
+		}
+	}
+	return sum;
+}
+
+// Accumulated times of an undirected graph.
+struct view_times {
+	// time to build the undirected graph (or view)
+	double construction = 0.0;
+	// time to traverse the neighbour lists once
+	double iteration = 0.0;
+};
+
+template <class directed_t>
+void to_undirected_and_view(
+	const directed_t& g, view_times& conversion, view_times& view
+) noexcept
+{
+	uint64_t sum_conversion, sum_view;
+	{
+		const auto begin = now();
+		const auto uG = g.to_undirected();
+		const auto middle = now();
+		sum_conversion = traverse(uG);
+		const auto end = now();
+		conversion.construction += elapsed_time(begin, middle);
+		conversion.iteration += elapsed_time(middle, end);
+	}
+	{
+		const auto begin = now();
+		const graphs::undirected_view uV(g);
+		const auto middle = now();
+		sum_view = traverse(uV);
+		const auto end = now();
+		view.construction += elapsed_time(begin, middle);
+		view.iteration += elapsed_time(middle, end);
+	}
+
+	if (sum_conversion != sum_view) {
+		std::cerr << "ERROR! The view and the conversion differ.\n";
+		std::abort();
+	}
+
+	// outside the timed regions
+	const auto uG = g.to_undirected();
+	const graphs::undirected_view uV(g);
+	bool equal = uG.get_num_edges() == uV.get_num_edges();
+	for (lal::node u = 0; u < uG.get_num_nodes(); ++u) {
+		equal = equal and uG.get_degree(u) == uV.get_degree(u);
+	}
+	if (not equal) {
+		std::cerr << "ERROR! The degrees or the number of edges of the view "
+					 "and the conversion differ.\n";
+		std::abort();
+	}
+}
+
+// The directed graph 'g' with the reversal of every other edge added, so that
+// half of its edges have a reciprocal edge.
+[[nodiscard]] lal::graphs::directed_graph
+with_reciprocal_edges(const lal::graphs::directed_graph& g) noexcept
+{
+	const std::vector<lal::edge> edges = g.get_edges();
+	std::vector<lal::edge> reversed;
+	reversed.reserve(edges.size() / 2 + 1);
+	for (std::size_t e = 0; e < edges.size(); e += 2) {
+		reversed.emplace_back(edges[e].second, edges[e].first);
+	}
+
+	lal::graphs::directed_graph r = g;
+	r.add_edges(reversed, true, false);
+	return r;
+}
+
+void output_view_times(
+	const std::string& graph_type,
+	const view_times& conversion,
+	const view_times& view,
+	const double num_calls
+) noexcept
+{
+	// milliseconds to nanoseconds per call
+	const double f = 1'000'000.0 / num_calls;
+
+	std::cout << "------------------------\n";
+	std::cout << graph_type << " (ns/call)\n";
+	std::cout << std::setw(16) << ' ' << std::setw(16) << "construction"
+			  << std::setw(16) << "iteration" << std::setw(16) << "total"
+			  << '\n';
+	std::cout << std::setw(16) << "to_undirected" << std::setw(16)
+			  << conversion.construction * f << std::setw(16)
+			  << conversion.iteration * f << std::setw(16)
+			  << (conversion.construction + conversion.iteration) * f << '\n';
+	std::cout << std::setw(16) << "view" << std::setw(16)
+			  << view.construction * f << std::setw(16) << view.iteration * f
+			  << std::setw(16) << (view.construction + view.iteration) * f
+			  << '\n';
+}
+
+void view(
+	const std::size_t num_calls, const uint64_t n, const uint64_t T
+) noexcept
+{
+	view_times dgraph_conversion, dgraph_view;
+	view_times rtree_conversion, rtree_view;
+	view_times recip_conversion, recip_view;
+
+	lal::generate::rand_ulab_rooted_trees Gen(n);
+	for (uint64_t t = 0; t < T; ++t) {
+		const auto rT = Gen.get_tree();
+		const auto dG = static_cast<lal::graphs::directed_graph>(rT);
+		const auto dR = with_reciprocal_edges(dG);
+
+		for (size_t i = 0; i < num_calls; ++i) {
+			to_undirected_and_view(dG, dgraph_conversion, dgraph_view);
+			to_undirected_and_view(rT, rtree_conversion, rtree_view);
+			to_undirected_and_view(dR, recip_conversion, recip_view);
+		}
+	}
+
+	const double calls = static_cast<double>(num_calls * T);
+	std::cout << "Number of vertices: " << n << '\n';
+	std::cout << "Total calls: " << num_calls * T << '\n';
+	std::cout << std::fixed << std::setprecision(2);
+	output_view_times("directed_graph", dgraph_conversion, dgraph_view, calls);
+	output_view_times("rooted_tree", rtree_conversion, rtree_view, calls);
+	output_view_times(
+		"directed_graph (reciprocal edges)", recip_conversion, recip_view, calls
+	);
+}
+
 } // namespace dir_to_undir
 
 void conversion(uint64_t argc, char *argv[]) noexcept
@@ -126,6 +273,9 @@ void conversion(uint64_t argc, char *argv[]) noexcept
 	if (mode == "rtree_to_ftree") {
 		dir_to_undir::rtree_to_ftree(C, n, T);
 	}
+	if (mode == "view") {
+		dir_to_undir::view(C, n, T);
+	}
 }
 
 } // namespace profiling
@@ -0,0 +1,69 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "csr_graph.hpp"
+
+namespace profiling {
+namespace graphs {
+
+csr_undirected_graph freeze(const lal::graphs::undirected_graph& g) noexcept
+{
+	csr_undirected_graph csr;
+	csr.m_adj.build(
+		g.get_num_nodes(),
+		[&](const lal::node u) -> const lal::neighbourhood&
+		{
+			return g.get_neighbors(u);
+		}
+	);
+	csr.m_num_edges = g.get_num_edges();
+	return csr;
+}
+
+csr_directed_graph freeze(const lal::graphs::directed_graph& g) noexcept
+{
+	csr_directed_graph csr;
+	csr.m_out.build(
+		g.get_num_nodes(),
+		[&](const lal::node u) -> const lal::neighbourhood&
+		{
+			return g.get_out_neighbors(u);
+		}
+	);
+	csr.m_in.build(
+		g.get_num_nodes(),
+		[&](const lal::node u) -> const lal::neighbourhood&
+		{
+			return g.get_in_neighbors(u);
+		}
+	);
+	csr.m_num_edges = g.get_num_edges();
+	return csr;
+}
+
+} // namespace graphs
+} // namespace profiling
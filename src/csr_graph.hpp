@@ -0,0 +1,204 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// lal includes
+#include <lal/basic_types.hpp>
+#include <lal/graphs/directed_graph.hpp>
+#include <lal/graphs/undirected_graph.hpp>
+
+namespace profiling {
+namespace graphs {
+
+/*
+ * Adjacency lists in compressed sparse row form.
+ *
+ * The lists of all vertices are stored one after the other in a single
+ * array, and the list of vertex u is [offsets[u], offsets[u + 1]). Reading
+ * the lists of consecutive vertices reads consecutive memory, instead of
+ * following one pointer per vertex as in the vector-per-vertex layout of
+ * LAL's graphs. Every list is sorted.
+ */
+class csr_adjacency {
+public:
+
+	// Copies the lists of the n vertices of a graph. 'list' maps every
+	// vertex to its lal::neighbourhood.
+	template <typename Callable>
+	void build(const uint64_t n, const Callable& list) noexcept
+	{
+		m_offsets.resize(n + 1);
+		m_offsets[0] = 0;
+		for (lal::node u = 0; u < n; ++u) {
+			m_offsets[u + 1] = m_offsets[u] + list(u).size();
+		}
+
+		m_neighbors.resize(m_offsets[n]);
+		for (lal::node u = 0; u < n; ++u) {
+			const lal::neighbourhood& l = list(u);
+			lal::node * const b = m_neighbors.data() + m_offsets[u];
+			std::copy(l.begin(), l.end(), b);
+			std::sort(b, b + l.size());
+		}
+	}
+
+	[[nodiscard]] uint64_t num_nodes() const noexcept
+	{
+		return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+	}
+	[[nodiscard]] std::span<const lal::node>
+	neighbors(const lal::node u) const noexcept
+	{
+		return {m_neighbors.data() + m_offsets[u], degree(u)};
+	}
+	[[nodiscard]] uint64_t degree(const lal::node u) const noexcept
+	{
+		return m_offsets[u + 1] - m_offsets[u];
+	}
+	[[nodiscard]] bool
+	contains(const lal::node u, const lal::node v) const noexcept
+	{
+		const std::span<const lal::node> l = neighbors(u);
+		return std::binary_search(l.begin(), l.end(), v);
+	}
+
+private:
+
+	std::vector<std::size_t> m_offsets;
+	std::vector<lal::node> m_neighbors;
+};
+
+/*
+ * Immutable snapshots of LAL's graphs in compressed sparse row form, built
+ * with freeze(). They have the read-only interface of the graph they were
+ * built from (neighbours, degrees and has_edge), so templated read-only
+ * phases accept either. A snapshot is not updated when the graph changes.
+ */
+
+// Snapshot of an undirected graph or a free tree.
+class csr_undirected_graph {
+public:
+
+	[[nodiscard]] uint64_t get_num_nodes() const noexcept
+	{
+		return m_adj.num_nodes();
+	}
+	[[nodiscard]] uint64_t get_num_edges() const noexcept
+	{
+		return m_num_edges;
+	}
+	[[nodiscard]] std::span<const lal::node>
+	get_neighbors(const lal::node u) const noexcept
+	{
+		return m_adj.neighbors(u);
+	}
+	[[nodiscard]] uint64_t get_degree(const lal::node u) const noexcept
+	{
+		return m_adj.degree(u);
+	}
+	[[nodiscard]] bool
+	has_edge(const lal::node u, const lal::node v) const noexcept
+	{
+		return m_adj.contains(u, v);
+	}
+
+private:
+
+	friend csr_undirected_graph
+	freeze(const lal::graphs::undirected_graph& g) noexcept;
+
+	csr_adjacency m_adj;
+	uint64_t m_num_edges = 0;
+};
+
+// Snapshot of a directed graph or a rooted tree.
+class csr_directed_graph {
+public:
+
+	[[nodiscard]] uint64_t get_num_nodes() const noexcept
+	{
+		return m_out.num_nodes();
+	}
+	[[nodiscard]] uint64_t get_num_edges() const noexcept
+	{
+		return m_num_edges;
+	}
+	[[nodiscard]] std::span<const lal::node>
+	get_out_neighbors(const lal::node u) const noexcept
+	{
+		return m_out.neighbors(u);
+	}
+	[[nodiscard]] std::span<const lal::node>
+	get_in_neighbors(const lal::node u) const noexcept
+	{
+		return m_in.neighbors(u);
+	}
+	[[nodiscard]] uint64_t get_out_degree(const lal::node u) const noexcept
+	{
+		return m_out.degree(u);
+	}
+	[[nodiscard]] uint64_t get_in_degree(const lal::node u) const noexcept
+	{
+		return m_in.degree(u);
+	}
+	[[nodiscard]] uint64_t get_degree(const lal::node u) const noexcept
+	{
+		return m_out.degree(u) + m_in.degree(u);
+	}
+	[[nodiscard]] bool
+	has_edge(const lal::node u, const lal::node v) const noexcept
+	{
+		return m_out.contains(u, v);
+	}
+
+private:
+
+	friend csr_directed_graph
+	freeze(const lal::graphs::directed_graph& g) noexcept;
+
+	csr_adjacency m_out;
+	csr_adjacency m_in;
+	uint64_t m_num_edges = 0;
+};
+
+// Snapshot of an undirected graph or a free tree.
+[[nodiscard]] csr_undirected_graph
+freeze(const lal::graphs::undirected_graph& g) noexcept;
+
+// Snapshot of a directed graph or a rooted tree.
+[[nodiscard]] csr_directed_graph
+freeze(const lal::graphs::directed_graph& g) noexcept;
+
+} // namespace graphs
+} // namespace profiling
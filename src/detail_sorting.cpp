@@ -26,14 +26,22 @@
  ***********************************************************************/
 
 // C++ includes
+#include <algorithm>
+#include <array>
+#include <iomanip>
 #include <iostream>
+#include <numeric>
 #include <random>
+#include <utility>
 
 // lal includes
+#include <lal/detail/sorting/bit_sort.hpp>
+#include <lal/detail/sorting/counting_sort.hpp>
 #include <lal/detail/sorting/insertion_sort.hpp>
 
 // common includes
 #include "time.hpp"
+#include "detail_sorting_parallel.hpp"
 #include "detail_sorting_pp.hpp"
 
 namespace profiling {
@@ -94,6 +102,350 @@ void insertion_sort_string(const uint64_t n, const uint64_t R) noexcept
 			  << time_to_str(total_time / static_cast<double>(R)) << '\n';
 }
 
+// Key of the elements sorted in the suite.
+[[nodiscard]] inline uint64_t key_of(const uint64_t v) noexcept
+{
+	return v;
+}
+[[nodiscard]] inline uint64_t
+key_of(const std::pair<uint64_t, uint64_t>& p) noexcept
+{
+	return p.first;
+}
+
+// Element of the suite with key 'k' at position 'i' of the input. Pairs
+// store the position so that sorting them by key is stable, and all
+// algorithms, stable or not, produce the same sequence.
+template <typename T>
+[[nodiscard]] T make_element(const uint64_t k, const uint64_t i) noexcept
+{
+	if constexpr (std::is_same_v<T, uint64_t>) {
+		return k;
+	}
+	else {
+		return {k, i};
+	}
+}
+
+// Fills 'v' with n elements whose keys, all in [0,n), follow distribution
+// 'dist'.
+template <typename T>
+void make_input(
+	const std::string& dist,
+	const uint64_t n,
+	std::mt19937_64& gen,
+	std::vector<T>& v
+) noexcept
+{
+	std::vector<uint64_t> keys(n);
+	std::iota(keys.begin(), keys.end(), 0);
+
+	if (dist == "reversed") {
+		std::reverse(keys.begin(), keys.end());
+	}
+	else if (dist == "nearly_sorted") {
+		// swap 1% of the elements
+		std::uniform_int_distribution<uint64_t> U(0, n - 1);
+		for (uint64_t s = 0; s < std::max<uint64_t>(1, n / 100); ++s) {
+			std::swap(keys[U(gen)], keys[U(gen)]);
+		}
+	}
+	else if (dist == "few_unique") {
+		// 8 different keys, evenly spread in [0,n)
+		std::uniform_int_distribution<uint64_t> U(0, 7);
+		for (uint64_t& k : keys) {
+			k = U(gen) * (n / 8);
+		}
+	}
+	else if (dist == "organ_pipe") {
+		for (uint64_t i = 0; i < n; ++i) {
+			keys[i] = std::min(i, n - 1 - i);
+		}
+	}
+	else if (dist == "random") {
+		std::shuffle(keys.begin(), keys.end(), gen);
+	}
+
+	v.resize(n);
+	for (uint64_t i = 0; i < n; ++i) {
+		v[i] = make_element<T>(keys[i], i);
+	}
+}
+
+// Least significant digit radix sort of the keys, 8 bits per pass. Only the
+// bytes needed to represent 'max_key' are sorted.
+template <typename T>
+void radix_sort(
+	T * const begin,
+	T * const end,
+	const uint64_t max_key,
+	std::vector<T>& buffer
+) noexcept
+{
+	const std::size_t n = static_cast<std::size_t>(end - begin);
+	buffer.resize(n);
+
+	T *from = begin;
+	T *to = buffer.data();
+	for (uint64_t shift = 0; shift < 64 and (max_key >> shift) > 0;
+		 shift += 8) {
+		std::array<std::size_t, 257> count{};
+		for (std::size_t i = 0; i < n; ++i) {
+			++count[((key_of(from[i]) >> shift) & 0xff) + 1];
+		}
+		for (std::size_t d = 1; d < count.size(); ++d) {
+			count[d] += count[d - 1];
+		}
+		for (std::size_t i = 0; i < n; ++i) {
+			to[count[(key_of(from[i]) >> shift) & 0xff]++] = from[i];
+		}
+		std::swap(from, to);
+	}
+	if (from != begin) {
+		std::copy(from, from + n, begin);
+	}
+}
+
+// Whether algorithm 'algo' is measured on the given input.
+template <typename T>
+[[nodiscard]] bool is_measured(
+	const std::string& algo,
+	const std::string& dist,
+	const uint64_t n,
+	const uint64_t insertion_limit
+) noexcept
+{
+	if (algo == "insertion") {
+		return n <= insertion_limit;
+	}
+	if (algo == "bit") {
+		// bit sort needs integers without repetitions
+		return std::is_same_v<T, uint64_t> and dist != "few_unique" and
+			   dist != "organ_pipe";
+	}
+	return true;
+}
+
+// Sorts [begin,end) with algorithm 'algo'. All keys are smaller than 'n'.
+template <typename T>
+void sort_with(
+	const std::string& algo,
+	T * const begin,
+	T * const end,
+	const uint64_t n,
+	std::vector<T>& buffer
+) noexcept
+{
+	const std::size_t size = static_cast<std::size_t>(end - begin);
+
+	if (algo == "insertion") {
+		lal::detail::sorting::insertion_sort(begin, end);
+	}
+	else if (algo == "bit") {
+		if constexpr (std::is_same_v<T, uint64_t>) {
+			lal::detail::sorting::bit_sort<T>(begin, end, size);
+		}
+	}
+	else if (algo == "counting") {
+		lal::detail::sorting::counting_sort<
+			T,
+			lal::detail::sorting::sort_type::non_decreasing>(
+			begin,
+			end,
+			n,
+			size,
+			[](const T& t) -> std::size_t
+			{
+				return key_of(t);
+			}
+		);
+	}
+	else if (algo == "radix") {
+		radix_sort(begin, end, n - 1, buffer);
+	}
+	else if (algo == "std_sort") {
+		std::sort(begin, end);
+	}
+	else if (algo == "std_stable_sort") {
+		std::stable_sort(begin, end);
+	}
+}
+
+// Number of elements sorted between two measurements of the time. Small
+// inputs are copied several times into one buffer so that the cost of
+// reading the clock is spread over many sorts.
+static constexpr uint64_t batch_elements = 1 << 16;
+
+// Measures the time, in ns per element, that 'sort' takes to sort 'input'.
+// 'algo' names the algorithm in error messages.
+template <typename T, typename Sort>
+[[nodiscard]] double ns_per_element(
+	const std::string& algo,
+	const std::vector<T>& input,
+	const double min_time,
+	const Sort& sort
+) noexcept
+{
+	const uint64_t n = input.size();
+	const uint64_t copies = std::max<uint64_t>(1, batch_elements / n);
+
+	std::vector<T> work(copies * n);
+
+	double total_time = 0;
+	uint64_t num_sorted = 0;
+	do {
+		for (uint64_t c = 0; c < copies; ++c) {
+			std::copy(input.begin(), input.end(), work.data() + c * n);
+		}
+
+		const auto begin = now();
+		for (uint64_t c = 0; c < copies; ++c) {
+			T * const b = work.data() + c * n;
+			sort(b, b + n);
+		}
+		const auto end = now();
+
+		total_time += elapsed_time(begin, end);
+		num_sorted += copies * n;
+	}
+	while (total_time < min_time);
+
+	if (not std::is_sorted(work.data(), work.data() + n)) {
+		std::cerr << "ERROR! Algorithm '" << algo << "' did not sort.\n";
+		std::abort();
+	}
+
+	// milliseconds to nanoseconds
+	return total_time * 1'000'000.0 / static_cast<double>(num_sorted);
+}
+
+template <typename T>
+void suite(const detail_sorting_pp& parser) noexcept
+{
+	const std::vector<std::string>& algorithms = parser.get_algorithms();
+
+	std::mt19937_64 gen(1234);
+	std::vector<T> input;
+	std::vector<T> buffer;
+
+	std::cout << std::fixed << std::setprecision(2);
+	for (const std::string& dist : parser.get_distributions()) {
+		std::cout << "------------------------\n";
+		std::cout << "Distribution: " << dist << " (ns/element)\n";
+		std::cout << std::setw(10) << "n";
+		for (const std::string& algo : algorithms) {
+			std::cout << std::setw(17) << algo;
+		}
+		std::cout << '\n';
+
+		for (const uint64_t n : parser.get_sizes()) {
+			make_input(dist, n, gen, input);
+
+			std::cout << std::setw(10) << n;
+			for (const std::string& algo : algorithms) {
+				if (not is_measured<T>(
+						algo, dist, n, parser.get_insertion_limit()
+					)) {
+					std::cout << std::setw(17) << '-';
+					continue;
+				}
+				const auto sort = [&](T * const b, T * const e)
+				{
+					sort_with(algo, b, e, n, buffer);
+				};
+				std::cout << std::setw(17)
+						  << ns_per_element(
+								 algo, input, parser.get_min_time(), sort
+							 )
+						  << std::flush;
+			}
+			std::cout << '\n';
+		}
+	}
+}
+
+// Sorts n elements with random keys in [0,K) with the sequential routine and
+// with its parallel version for 1, 2, 4, ..., P threads.
+template <typename T>
+void parallel(const detail_sorting_pp& parser) noexcept
+{
+	const bool counting = parser.get_mode() == "parallel_counting";
+	const uint64_t max_threads = parser.get_threads();
+	const double min_time = parser.get_min_time();
+
+	const auto key = [](const T& t) -> std::size_t
+	{
+		return key_of(t);
+	};
+
+	std::mt19937_64 gen(1234);
+	std::vector<T> input;
+	std::vector<T> buffer;
+	std::vector<std::size_t> count;
+
+	std::cout << std::fixed << std::setprecision(2);
+	for (const uint64_t n : parser.get_sizes()) {
+		const uint64_t K = parser.has_keys() ? parser.get_keys() : n;
+
+		std::uniform_int_distribution<uint64_t> U(0, K - 1);
+		input.resize(n);
+		for (uint64_t i = 0; i < n; ++i) {
+			input[i] = make_element<T>(U(gen), i);
+		}
+
+		std::cout << "------------------------\n";
+		std::cout << "Elements: " << n << ", keys in [0," << K << ")\n";
+		std::cout << std::setw(12) << "threads" << std::setw(14)
+				  << "ns/element" << std::setw(10) << "GB/s" << std::setw(10)
+				  << "speedup" << '\n';
+
+		const auto print_row = [&](const std::string& threads,
+								   const double ns,
+								   const double base)
+		{
+			// bytes of the input sorted per nanosecond
+			std::cout << std::setw(12) << threads << std::setw(14) << ns
+					  << std::setw(10)
+					  << static_cast<double>(sizeof(T)) / ns << std::setw(10)
+					  << base / ns << '\n';
+		};
+
+		const auto sequential = [&](T * const b, T * const e)
+		{
+			if (counting) {
+				sort_with("counting", b, e, K, buffer);
+			}
+			else {
+				sort_with("radix", b, e, K, buffer);
+			}
+		};
+		const double base = ns_per_element(
+			counting ? "counting" : "radix", input, min_time, sequential
+		);
+		print_row("sequential", base, base);
+
+		for (uint64_t t = 1;; t = std::min(2 * t, max_threads)) {
+			const int P = static_cast<int>(t);
+			const auto par = [&](T * const b, T * const e)
+			{
+				if (counting) {
+					parallel_counting_sort(b, e, K, key, buffer, count, P);
+				}
+				else {
+					parallel_radix_sort(b, e, K - 1, key, buffer, count, P);
+				}
+			};
+			const double ns =
+				ns_per_element(parser.get_mode(), input, min_time, par);
+			print_row(std::to_string(t), ns, base);
+
+			if (t == max_threads) {
+				break;
+			}
+		}
+	}
+}
+
 } // namespace detail_sorting
 
 void detail_sorting_algorithms(uint64_t argc, char *argv[]) noexcept
@@ -108,6 +460,26 @@ void detail_sorting_algorithms(uint64_t argc, char *argv[]) noexcept
 		}
 	}
 
+	if (parser.get_mode() == "suite") {
+		if (parser.get_type() == "int") {
+			detail_sorting::suite<uint64_t>(parser);
+		}
+		else {
+			detail_sorting::suite<std::pair<uint64_t, uint64_t>>(parser);
+		}
+		return;
+	}
+	if (parser.get_mode() == "parallel_counting" or
+		parser.get_mode() == "parallel_radix") {
+		if (parser.get_type() == "int") {
+			detail_sorting::parallel<uint64_t>(parser);
+		}
+		else {
+			detail_sorting::parallel<std::pair<uint64_t, uint64_t>>(parser);
+		}
+		return;
+	}
+
 	if (parser.get_algo() == "insertion") {
 		detail_sorting::insertion_sort_int(parser.get_n(), parser.get_R());
 		detail_sorting::insertion_sort_string(parser.get_n(), parser.get_R());
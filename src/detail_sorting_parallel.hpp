@@ -0,0 +1,199 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// omp includes
+#include <omp.h>
+
+namespace profiling {
+namespace detail_sorting {
+
+/*
+ * Multi-threaded stable sorts of integer keys.
+ *
+ * The input is split into one contiguous chunk per thread. Every thread
+ * counts the keys of its chunk in its own histogram. A prefix sum over the
+ * histograms, ordered by key and then by thread, gives every thread the
+ * position where its first element with every key goes. Then every thread
+ * scatters its chunk to the positions it was given. No two threads write
+ * the same position, and elements with equal keys keep their relative order.
+ *
+ * 'key' maps every element to its key, as in the counting sort of
+ * lal::detail::sorting. 'buffer' is resized to the size of the input, and
+ * the sorted sequence is left in [begin,end).
+ */
+
+// Counting sort of keys in [0, largest_key_plus_1). The histograms take
+// num_threads * largest_key_plus_1 counters, and the prefix sum is computed
+// in parallel over ranges of keys.
+template <typename T, typename Callable>
+void parallel_counting_sort(
+	T * const begin,
+	T * const end,
+	const std::size_t largest_key_plus_1,
+	const Callable& key,
+	std::vector<T>& buffer,
+	std::vector<std::size_t>& count,
+	const int num_threads
+) noexcept
+{
+	const std::size_t n = static_cast<std::size_t>(end - begin);
+	const std::size_t K = largest_key_plus_1;
+	buffer.resize(n);
+	count.resize(static_cast<std::size_t>(num_threads) * K);
+	std::vector<std::size_t> range_sum(static_cast<std::size_t>(num_threads));
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		const std::size_t P = static_cast<std::size_t>(omp_get_num_threads());
+		const std::size_t t = static_cast<std::size_t>(omp_get_thread_num());
+		const std::size_t lo = n * t / P;
+		const std::size_t hi = n * (t + 1) / P;
+		const std::size_t k_lo = K * t / P;
+		const std::size_t k_hi = K * (t + 1) / P;
+		std::size_t * const c = &count[t * K];
+
+		std::fill(c, c + K, 0);
+		for (std::size_t i = lo; i < hi; ++i) {
+			++c[key(begin[i])];
+		}
+#pragma omp barrier
+
+		// number of elements with keys in this thread's range
+		std::size_t s = 0;
+		for (std::size_t k = k_lo; k < k_hi; ++k) {
+			for (std::size_t u = 0; u < P; ++u) {
+				s += count[u * K + k];
+			}
+		}
+		range_sum[t] = s;
+#pragma omp barrier
+#pragma omp single
+		{
+			std::size_t sum = 0;
+			for (std::size_t u = 0; u < P; ++u) {
+				const std::size_t r = range_sum[u];
+				range_sum[u] = sum;
+				sum += r;
+			}
+		}
+
+		// positions of the first element of every key and thread
+		std::size_t pos = range_sum[t];
+		for (std::size_t k = k_lo; k < k_hi; ++k) {
+			for (std::size_t u = 0; u < P; ++u) {
+				const std::size_t r = count[u * K + k];
+				count[u * K + k] = pos;
+				pos += r;
+			}
+		}
+#pragma omp barrier
+
+		for (std::size_t i = lo; i < hi; ++i) {
+			buffer[c[key(begin[i])]++] = begin[i];
+		}
+#pragma omp barrier
+
+		std::copy(buffer.data() + lo, buffer.data() + hi, begin + lo);
+	}
+}
+
+// Least significant digit radix sort, 8 bits per pass. Only the bytes needed
+// to represent 'max_key' are sorted. The histograms take num_threads * 256
+// counters.
+template <typename T, typename Callable>
+void parallel_radix_sort(
+	T * const begin,
+	T * const end,
+	const uint64_t max_key,
+	const Callable& key,
+	std::vector<T>& buffer,
+	std::vector<std::size_t>& count,
+	const int num_threads
+) noexcept
+{
+	static constexpr std::size_t D = 256;
+
+	const std::size_t n = static_cast<std::size_t>(end - begin);
+	buffer.resize(n);
+	count.resize(static_cast<std::size_t>(num_threads) * D);
+
+	T *from = begin;
+	T *to = buffer.data();
+	for (uint64_t shift = 0; shift < 64 and (max_key >> shift) > 0;
+		 shift += 8) {
+
+#pragma omp parallel num_threads(num_threads)
+		{
+			const std::size_t P =
+				static_cast<std::size_t>(omp_get_num_threads());
+			const std::size_t t =
+				static_cast<std::size_t>(omp_get_thread_num());
+			const std::size_t lo = n * t / P;
+			const std::size_t hi = n * (t + 1) / P;
+			std::size_t * const c = &count[t * D];
+
+			std::fill(c, c + D, 0);
+			for (std::size_t i = lo; i < hi; ++i) {
+				++c[(key(from[i]) >> shift) & 0xff];
+			}
+#pragma omp barrier
+#pragma omp single
+			{
+				std::size_t pos = 0;
+				for (std::size_t d = 0; d < D; ++d) {
+					for (std::size_t u = 0; u < P; ++u) {
+						const std::size_t r = count[u * D + d];
+						count[u * D + d] = pos;
+						pos += r;
+					}
+				}
+			}
+
+			for (std::size_t i = lo; i < hi; ++i) {
+				to[c[(key(from[i]) >> shift) & 0xff]++] = from[i];
+			}
+		}
+		std::swap(from, to);
+	}
+
+	if (from != begin) {
+#pragma omp parallel for num_threads(num_threads)
+		for (std::size_t i = 0; i < n; ++i) {
+			begin[i] = from[i];
+		}
+	}
+}
+
+} // namespace detail_sorting
+} // namespace profiling
@@ -30,6 +30,7 @@
 // C++ includes
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
 
 namespace profiling {
 namespace detail_sorting {
@@ -43,21 +44,82 @@ detail_sorting_pp::~detail_sorting_pp() noexcept { }
 void detail_sorting_pp::print_usage() const noexcept
 {
 	// clang-format off
-	std::cout << "Profiling -- Calculation of minimum D\n";
-	std::cout << "=====================================\n";
+	std::cout << "Profiling -- Sorting algorithms\n";
+	std::cout << "===============================\n";
 	std::cout << '\n';
 	std::cout << "This program's options are the following:\n";
 	std::cout << "    Those marked with [*] are mandatory for all execution modes.\n";
 	std::cout << "    Those marked with [i] are mandatory for execution mode i.\n";
 	std::cout << "    Those marked with [?] are optional.\n";
 	std::cout << '\n';
-	std::cout << "    [*]   -n n\n";
+	std::cout << "    [?]   -mode m\n";
+	std::cout << "          Execution mode:\n";
+	std::cout << "          [1] single: sort n random elements R times with one\n";
+	std::cout << "              algorithm.\n";
+	std::cout << "          [2] suite: measure every algorithm in -algorithms on\n";
+	std::cout << "              every distribution in -distributions and every size\n";
+	std::cout << "              in -sizes, in ns/element.\n";
+	std::cout << "          [3] parallel_counting, parallel_radix: sort random keys\n";
+	std::cout << "              with the multi-threaded counting or radix sort\n";
+	std::cout << "              using 1, 2, 4, ..., P threads, and compare them\n";
+	std::cout << "              with the sequential routine. Reports ns/element,\n";
+	std::cout << "              GB/s of input sorted, and speedup.\n";
+	std::cout << "          Default: single\n";
+	std::cout << '\n';
+	std::cout << "    [1]   -n n\n";
 	std::cout << "          Indicate the number elements to sort.\n";
 	std::cout << '\n';
-	std::cout << "    [*]   -R r\n";
+	std::cout << "    [1]   -R r\n";
 	std::cout << "          Indicate the number times to run the algorithm.\n";
 	std::cout << '\n';
-	std::cout << "    [*]   -algorithm A\n";
+	std::cout << "    [?]   -algorithms a_1,a_2,...,a_k\n";
+	std::cout << "          Algorithms of the suite. Bit sort is only measured on\n";
+	std::cout << "          integers without repetitions, and insertion sort only\n";
+	std::cout << "          up to -insertion-limit elements.\n";
+	std::cout << "          Default: all\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -distributions d_1,d_2,...,d_k\n";
+	std::cout << "          Input distributions of the suite. All keys are in\n";
+	std::cout << "          [0,n).\n";
+	std::cout << "         ";
+	for (const std::string& d : m_allowed_distributions) {
+	std::cout << ' ' << d;
+	}
+	std::cout << '\n';
+	std::cout << "          Default: all\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -sizes n_1,n_2,...,n_k\n";
+	std::cout << "          Numbers of elements of the suite and the parallel modes.\n";
+	std::cout << "          Default (suite): 8,64,512,4096,32768,262144,2097152,\n";
+	std::cout << "              10000000\n";
+	std::cout << "          Default (parallel): 1000000,10000000\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -type t\n";
+	std::cout << "          Type of the elements of the suite:\n";
+	std::cout << "          [1] int: 64-bit integers.\n";
+	std::cout << "          [2] pair: pairs of 64-bit integers sorted by the first\n";
+	std::cout << "              component. The second is the original position.\n";
+	std::cout << "          Default: int\n";
+	std::cout << '\n';
+	std::cout << "    [3]   -threads P\n";
+	std::cout << "          Maximum number of threads of the parallel sorts.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -keys K\n";
+	std::cout << "          Keys of the parallel sorts are in [0,K). Parallel\n";
+	std::cout << "          counting sort uses P*K counters.\n";
+	std::cout << "          Default: the number of elements\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -min-time t\n";
+	std::cout << "          Minimum time (in ms) spent measuring every cell of the\n";
+	std::cout << "          suite and the parallel modes.\n";
+	std::cout << "          Default: 100\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -insertion-limit n\n";
+	std::cout << "          Largest number of elements sorted with insertion sort\n";
+	std::cout << "          in the suite.\n";
+	std::cout << "          Default: 32768\n";
+	std::cout << '\n';
+	std::cout << "    [1]   -algorithm A\n";
 	std::cout << "          Indicate the algorithm to profile:\n";
 	std::cout << "              insertion\n";
 	std::cout << '\n';
@@ -68,6 +130,27 @@ void detail_sorting_pp::print_usage() const noexcept
 	// clang-format on
 }
 
+namespace {
+
+template <typename T>
+[[nodiscard]] std::vector<T> split(const char *list) noexcept
+{
+	std::vector<T> values;
+	std::stringstream ss(list);
+	std::string v;
+	while (std::getline(ss, v, ',')) {
+		if constexpr (std::is_same_v<T, std::string>) {
+			values.push_back(v);
+		}
+		else {
+			values.push_back(static_cast<uint64_t>(atoll(v.c_str())));
+		}
+	}
+	return values;
+}
+
+} // namespace
+
 int detail_sorting_pp::parse_params() noexcept
 {
 	if (m_argc == 0) {
@@ -96,17 +179,106 @@ int detail_sorting_pp::parse_params() noexcept
 			m_algo = std::string(m_argv[i + 1]);
 			++i;
 		}
+		else if (param == "-mode") {
+			m_mode = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-algorithms") {
+			m_algorithms = split<std::string>(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-distributions") {
+			m_distributions = split<std::string>(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-sizes") {
+			m_sizes = split<uint64_t>(m_argv[i + 1]);
+			m_has_sizes = true;
+			++i;
+		}
+		else if (param == "-threads") {
+			m_threads = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			m_has_threads = true;
+			++i;
+		}
+		else if (param == "-keys") {
+			m_keys = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			m_has_keys = true;
+			++i;
+		}
+		else if (param == "-type") {
+			m_type = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-min-time") {
+			m_min_time = atof(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-insertion-limit") {
+			m_insertion_limit = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			++i;
+		}
 		else {
 			std::cerr << "Error: unrecognised option\n";
 			std::cerr << "    " << param << '\n';
 			return 2;
 		}
 	}
+
+	if (not m_has_sizes and m_mode != "single" and m_mode != "suite") {
+		m_sizes = {1000000, 10000000};
+	}
 	return 0;
 }
 
 int detail_sorting_pp::check_errors() const noexcept
 {
+	if (not m_allowed_modes.contains(m_mode)) {
+		std::cout << "Error: wrong mode '" << m_mode << "'.\n";
+		return 1;
+	}
+
+	if (m_mode == "parallel_counting" or m_mode == "parallel_radix") {
+		if (not m_has_threads) {
+			std::cout << "Error: missing parameter '-threads'.\n";
+			return 1;
+		}
+		if (m_threads == 0) {
+			std::cout << "Error: the number of threads must be positive.\n";
+			return 1;
+		}
+		if (m_has_keys and m_keys == 0) {
+			std::cout << "Error: the number of keys must be positive.\n";
+			return 1;
+		}
+	}
+
+	if (m_mode != "single") {
+		for (const std::string& a : m_algorithms) {
+			if (not m_allowed_algorithms.contains(a)) {
+				std::cout << "Error: unknown algorithm '" << a << "'.\n";
+				return 1;
+			}
+		}
+		for (const std::string& d : m_distributions) {
+			if (not m_allowed_distributions.contains(d)) {
+				std::cout << "Error: unknown distribution '" << d << "'.\n";
+				return 1;
+			}
+		}
+		for (const uint64_t s : m_sizes) {
+			if (s == 0) {
+				std::cout << "Error: the sizes must be positive.\n";
+				return 1;
+			}
+		}
+		if (not m_allowed_types.contains(m_type)) {
+			std::cout << "Error: wrong type '" << m_type << "'.\n";
+			return 1;
+		}
+		return 0;
+	}
+
 	if (not m_has_n) {
 		std::cout << "Error: missing parameter '-n'.\n";
 		return 1;
@@ -30,6 +30,7 @@
 // C++ includes
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <set>
 
 namespace profiling {
@@ -41,6 +42,10 @@ public:
 	detail_sorting_pp(uint64_t argc, char *argv[]) noexcept;
 	~detail_sorting_pp() noexcept;
 
+	[[nodiscard]] const std::string& get_mode() const noexcept
+	{
+		return m_mode;
+	}
 	[[nodiscard]] const std::string& get_algo() const noexcept
 	{
 		return m_algo;
@@ -53,6 +58,44 @@ public:
 	{
 		return m_R;
 	}
+	[[nodiscard]] const std::vector<std::string>&
+	get_algorithms() const noexcept
+	{
+		return m_algorithms;
+	}
+	[[nodiscard]] const std::vector<std::string>&
+	get_distributions() const noexcept
+	{
+		return m_distributions;
+	}
+	[[nodiscard]] const std::vector<uint64_t>& get_sizes() const noexcept
+	{
+		return m_sizes;
+	}
+	[[nodiscard]] const std::string& get_type() const noexcept
+	{
+		return m_type;
+	}
+	[[nodiscard]] double get_min_time() const noexcept
+	{
+		return m_min_time;
+	}
+	[[nodiscard]] uint64_t get_insertion_limit() const noexcept
+	{
+		return m_insertion_limit;
+	}
+	[[nodiscard]] uint64_t get_threads() const noexcept
+	{
+		return m_threads;
+	}
+	[[nodiscard]] bool has_keys() const noexcept
+	{
+		return m_has_keys;
+	}
+	[[nodiscard]] uint64_t get_keys() const noexcept
+	{
+		return m_keys;
+	}
 
 	void print_usage() const noexcept;
 
@@ -67,6 +110,9 @@ public:
 
 private:
 
+	// mode of the profiler
+	std::string m_mode = "single";
+
 	// algorithm to execute
 	std::string m_algo = "none";
 
@@ -78,8 +124,67 @@ private:
 	uint64_t m_R = 0;
 	bool m_has_R = false;
 
-	const std::set<std::string> m_allowed_algorithms =
-		std::set<std::string>({"insertion", "bit", "counting"});
+	// algorithms of the suite
+	std::vector<std::string> m_algorithms = {
+		"insertion",
+		"bit",
+		"counting",
+		"radix",
+		"std_sort",
+		"std_stable_sort",
+	};
+
+	// input distributions of the suite
+	std::vector<std::string> m_distributions = {
+		"sorted",
+		"reversed",
+		"nearly_sorted",
+		"few_unique",
+		"organ_pipe",
+		"random",
+	};
+
+	// numbers of elements of the suite
+	std::vector<uint64_t> m_sizes = {
+		8, 64, 512, 4096, 32768, 262144, 2097152, 10000000
+	};
+	bool m_has_sizes = false;
+
+	// type of the elements of the suite
+	std::string m_type = "int";
+
+	// minimum time (in ms) spent measuring every cell of the suite
+	double m_min_time = 100.0;
+
+	// largest number of elements sorted with insertion sort in the suite
+	uint64_t m_insertion_limit = 32768;
+
+	// maximum number of threads of the parallel sorts
+	uint64_t m_threads = 0;
+	bool m_has_threads = false;
+
+	// number of different keys of the parallel sorts
+	uint64_t m_keys = 0;
+	bool m_has_keys = false;
+
+	const std::set<std::string> m_allowed_modes =
+		std::set<std::string>(
+			{"single", "suite", "parallel_counting", "parallel_radix"}
+		);
+	const std::set<std::string> m_allowed_algorithms = std::set<std::string>(
+		{"insertion", "bit", "counting", "radix", "std_sort", "std_stable_sort"}
+	);
+	const std::set<std::string> m_allowed_distributions =
+		std::set<std::string>(
+			{"sorted",
+			 "reversed",
+			 "nearly_sorted",
+			 "few_unique",
+			 "organ_pipe",
+			 "random"}
+		);
+	const std::set<std::string> m_allowed_types =
+		std::set<std::string>({"int", "pair"});
 	uint64_t m_argc;
 	char **m_argv;
 };
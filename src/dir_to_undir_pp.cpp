@@ -64,6 +64,13 @@ void dir_to_undir::print_usage() const noexcept
 	std::cout << "          " << algo << '\n';
 	}
 	std::cout << '\n';
+	std::cout << "          Mode 'view' compares, for directed graphs and rooted\n";
+	std::cout << "          trees, the cost of building and traversing the graph\n";
+	std::cout << "          returned by to_undirected() with the cost of building\n";
+	std::cout << "          and traversing a non-owning undirected view. It also\n";
+	std::cout << "          uses directed graphs where half of the edges have a\n";
+	std::cout << "          reciprocal edge.\n";
+	std::cout << '\n';
 	// clang-format on
 }
 
@@ -89,7 +89,7 @@ private:
 	uint64_t m_C = 1;
 
 	const std::set<std::string> m_allowed_modes =
-		std::set<std::string>({"dgraph_to_ugraph", "rtree_to_ftree"});
+		std::set<std::string>({"dgraph_to_ugraph", "rtree_to_ftree", "view"});
 	uint64_t m_argc;
 	char **m_argv;
 };
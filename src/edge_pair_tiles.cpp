@@ -0,0 +1,138 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "edge_pair_tiles.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <vector>
+
+namespace profiling {
+namespace graphs {
+
+edge_pair_tiles::edge_pair_tiles(
+	const lal::edge_list& edges, const std::size_t tile_size
+) noexcept
+	: m_tile_size(tile_size),
+	  m_edges(edges)
+{
+	const std::size_t num_blocks =
+		(edges.size() + tile_size - 1) / tile_size;
+	m_tiles.reserve(num_blocks * (num_blocks + 1) / 2);
+	for (std::size_t J = 0; J < num_blocks; ++J) {
+		for (std::size_t I = 0; I <= J; ++I) {
+			m_tiles.emplace_back(I, J);
+		}
+	}
+}
+
+uint64_t edge_pair_tiles::tile_capacity(const std::size_t t) const noexcept
+{
+	const auto [I, J] = m_tiles[t];
+	const std::size_t m = m_edges.size();
+	const uint64_t size_I =
+		std::min(m, (I + 1) * m_tile_size) - I * m_tile_size;
+	const uint64_t size_J =
+		std::min(m, (J + 1) * m_tile_size) - J * m_tile_size;
+	return I == J ? size_I * (size_I - 1) / 2 : size_I * size_J;
+}
+
+uint64_t edge_pair_tiles::tile_size_of_Q(const std::size_t t) const noexcept
+{
+	const auto [I, J] = m_tiles[t];
+
+	// the endpoints of the edges of block B, sorted
+	const auto endpoints = [&](const std::size_t B)
+	{
+		const std::size_t end = std::min(m_edges.size(), (B + 1) * m_tile_size);
+		std::vector<lal::node> ends;
+		ends.reserve(2 * (end - B * m_tile_size));
+		for (std::size_t e = B * m_tile_size; e < end; ++e) {
+			ends.push_back(m_edges[e].first);
+			ends.push_back(m_edges[e].second);
+		}
+		std::sort(ends.begin(), ends.end());
+		return ends;
+	};
+
+	// length of the run of equal values of 'ends' that starts at i
+	const auto run = [](const std::vector<lal::node>& ends, const std::size_t i)
+	{
+		std::size_t j = i;
+		while (j < ends.size() and ends[j] == ends[i]) {
+			++j;
+		}
+		return j - i;
+	};
+
+	// all pairs of edges of the tile minus the pairs that share a vertex
+	uint64_t shared = 0;
+	const std::vector<lal::node> a = endpoints(I);
+	if (I == J) {
+		for (std::size_t i = 0; i < a.size();) {
+			const uint64_t c = run(a, i);
+			shared += c * (c - 1) / 2;
+			i += c;
+		}
+	}
+	else {
+		const std::vector<lal::node> b = endpoints(J);
+		std::size_t i = 0;
+		std::size_t j = 0;
+		while (i < a.size() and j < b.size()) {
+			if (a[i] < b[j]) {
+				i += run(a, i);
+			}
+			else if (b[j] < a[i]) {
+				j += run(b, j);
+			}
+			else {
+				const uint64_t ca = run(a, i);
+				const uint64_t cb = run(b, j);
+				shared += ca * cb;
+				i += ca;
+				j += cb;
+			}
+		}
+	}
+	return tile_capacity(t) - shared;
+}
+
+uint64_t size_of_Q(const lal::graphs::undirected_graph& g) noexcept
+{
+	// all pairs of edges minus the pairs that share a vertex
+	const uint64_t m = g.get_num_edges();
+	uint64_t q = m * (m - 1) / 2;
+	for (lal::node u = 0; u < g.get_num_nodes(); ++u) {
+		const uint64_t d = g.get_degree(u);
+		q -= d * (d - 1) / 2;
+	}
+	return q;
+}
+
+} // namespace graphs
+} // namespace profiling
@@ -0,0 +1,116 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// lal includes
+#include <lal/basic_types.hpp>
+#include <lal/graphs/undirected_graph.hpp>
+
+namespace profiling {
+namespace graphs {
+
+/*
+ * Cache-blocked enumeration of the set Q of pairs of independent edges.
+ *
+ * The edges are split into blocks of 'tile_size' consecutive edges, and the
+ * pairs of edges are grouped into tiles: the pairs with one edge in block I
+ * and the other in block J, for every I <= J. The two blocks of a tile fit in
+ * the cache, so all the pairs of a tile are enumerated without reading memory
+ * further away. Tiles are independent of each other: enumerating all the
+ * tiles, in any order and with any number of threads, enumerates every pair
+ * of Q exactly once.
+ */
+class edge_pair_tiles {
+public:
+
+	edge_pair_tiles(const lal::edge_list& edges, const std::size_t tile_size)
+		noexcept;
+
+	[[nodiscard]] std::size_t num_tiles() const noexcept
+	{
+		return m_tiles.size();
+	}
+
+	// Calls f(e1, e2) for every pair of independent edges of tile t.
+	template <typename Callable>
+	void for_each_in_tile(const std::size_t t, Callable&& f) const noexcept
+	{
+		const auto [I, J] = m_tiles[t];
+		const std::size_t m = m_edges.size();
+		const std::size_t i_end = std::min(m, (I + 1) * m_tile_size);
+		const std::size_t j_end = std::min(m, (J + 1) * m_tile_size);
+
+		for (std::size_t i = I * m_tile_size; i < i_end; ++i) {
+			const lal::edge e1 = m_edges[i];
+			const std::size_t j_begin = (I == J ? i + 1 : J * m_tile_size);
+			for (std::size_t j = j_begin; j < j_end; ++j) {
+				const lal::edge e2 = m_edges[j];
+				if (e1.first != e2.first and e1.first != e2.second and
+					e1.second != e2.first and e1.second != e2.second) {
+					f(e1, e2);
+				}
+			}
+		}
+	}
+
+	// Calls f(e1, e2) for every pair of independent edges.
+	template <typename Callable>
+	void for_each(Callable&& f) const noexcept
+	{
+		for (std::size_t t = 0; t < m_tiles.size(); ++t) {
+			for_each_in_tile(t, f);
+		}
+	}
+
+	// Largest number of pairs of edges in tile t, independent or not.
+	[[nodiscard]] uint64_t tile_capacity(const std::size_t t) const noexcept;
+
+	// Number of pairs of independent edges in tile t, counted from the
+	// endpoints of the edges of its blocks without enumerating the pairs.
+	[[nodiscard]] uint64_t tile_size_of_Q(const std::size_t t) const noexcept;
+
+private:
+
+	const std::size_t m_tile_size;
+	const lal::edge_list m_edges;
+	// the blocks of every tile, in increasing order of the second block
+	std::vector<std::pair<std::size_t, std::size_t>> m_tiles;
+};
+
+// Size of the set Q of pairs of independent edges of a graph.
+[[nodiscard]] uint64_t size_of_Q(const lal::graphs::undirected_graph& g)
+	noexcept;
+
+} // namespace graphs
+} // namespace profiling
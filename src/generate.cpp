@@ -26,8 +26,11 @@
  ***********************************************************************/
 
 // C++ includes
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 // lal includes
 #include <lal/iterators/E_iterator.hpp>
@@ -36,7 +39,9 @@
 // common includes
 #include "time.hpp"
 #include "generate_trees_pp.hpp"
+#include "generate_head_vectors.hpp"
 #include "generate_arrangements_pp.hpp"
+#include "generate_arrangements_parallel.hpp"
 
 namespace profiling {
 namespace generate {
@@ -115,6 +120,141 @@ void profile_random_trees(uint64_t n, uint64_t N, uint64_t R) noexcept
 	output_execution_time_trees(total, n, N, R);
 }
 
+// Number of trees that fit in the flat buffer of head vectors (or Prüfer
+// sequences). Trees are written cyclically into the buffer.
+static constexpr uint64_t flat_buffer_trees = 4096;
+
+void output_throughput_trees(
+	const std::string_view what,
+	const double total_ms,
+	const uint64_t N,
+	const uint64_t R
+) noexcept
+{
+	std::cout << what << '\n';
+	std::cout << "    Total execution time: "
+			  << profiling::time_to_str(total_ms) << '\n';
+	std::cout << "    Average (ms/get_tree): "
+			  << profiling::time_to_str(total_ms / static_cast<double>(R * N))
+			  << '\n';
+	std::cout << "    Trees/second: "
+			  << static_cast<double>(R * N) / (total_ms / 1000.0) << '\n';
+}
+
+template <class tree_t, class gen_t>
+double time_full_trees(const uint64_t n, const uint64_t N, const uint64_t R)
+	noexcept
+{
+	double total = 0.0;
+	uint64_t checksum = 0;
+
+	for (uint64_t r = 0; r < R; ++r) {
+		gen_t Gen(n, 1234);
+		Gen.deactivate_all_postprocessing_actions();
+
+		const auto begin = profiling::now();
+		for (uint64_t i = 0; i < N; ++i) {
+			const tree_t tree = Gen.get_tree();
+			checksum += tree.get_num_edges();
+		}
+		const auto end = profiling::now();
+		total += profiling::elapsed_time(begin, end);
+	}
+
+	if (checksum != R * N * (n - 1)) {
+		std::cerr << "ERROR! Wrong number of edges\n";
+	}
+	return total;
+}
+
+double time_flat_trees(
+	const bool rooted,
+	const bool Prufer,
+	const uint64_t n,
+	const uint64_t N,
+	const uint64_t R
+) noexcept
+{
+	const uint64_t len = Prufer ? (n <= 2 ? 0 : n - 2) : n;
+	const uint64_t B = std::min(N, flat_buffer_trees);
+	std::vector<uint64_t> buffer(B * len);
+
+	double total = 0.0;
+	uint64_t checksum = 0;
+
+	for (uint64_t r = 0; r < R; ++r) {
+		rand_lab_head_vectors Gen(n, 1234, rooted);
+
+		const auto begin = profiling::now();
+		for (uint64_t i = 0; i < N; ++i) {
+			uint64_t * const out = buffer.data() + (i % B) * len;
+			if (Prufer) {
+				Gen.get_Prufer_sequence(out);
+			}
+			else {
+				Gen.get_head_vector(out);
+			}
+		}
+		const auto end = profiling::now();
+		total += profiling::elapsed_time(begin, end);
+
+		for (const uint64_t v : buffer) {
+			checksum += v;
+		}
+	}
+
+#if defined DEBUG
+	for (uint64_t i = 0; i < B; ++i) {
+		if (len > 0) {
+			std::cout << buffer[i * len];
+		}
+		for (uint64_t j = 1; j < len; ++j) {
+			std::cout << ' ' << buffer[i * len + j];
+		}
+		std::cout << '\n';
+	}
+#endif
+
+	std::cout << "Checksum of the buffer: " << checksum << '\n';
+	return total;
+}
+
+template <class tree_t, class gen_t>
+void profile_flat_trees(
+	const std::string& output,
+	const uint64_t n,
+	const uint64_t N,
+	const uint64_t R
+) noexcept
+{
+	static constexpr bool rooted =
+		std::is_same_v<tree_t, lal::graphs::rooted_tree>;
+
+	std::cout << "n= " << n << '\n';
+	std::cout << "N= " << N << '\n';
+	std::cout << "R= " << R << '\n';
+
+	double full = 0.0;
+	if (output == "compare") {
+		full = time_full_trees<tree_t, gen_t>(n, N, R);
+		output_throughput_trees("Full object", full, N, R);
+	}
+	if (output == "head_vector" or output == "compare") {
+		const double hv = time_flat_trees(rooted, false, n, N, R);
+		output_throughput_trees("Head vector only", hv, N, R);
+		if (output == "compare") {
+			std::cout << "    Speedup over full object: " << full / hv << '\n';
+		}
+	}
+	if (output == "Prufer" or output == "compare") {
+		const double pr = time_flat_trees(rooted, true, n, N, R);
+		output_throughput_trees("Prufer sequence only", pr, N, R);
+		if (output == "compare") {
+			std::cout << "    Speedup over full object: " << full / pr << '\n';
+		}
+	}
+}
+
 } // namespace generate
 
 void generate_trees(uint64_t argc, char *argv[]) noexcept
@@ -134,6 +274,21 @@ void generate_trees(uint64_t argc, char *argv[]) noexcept
 	const uint64_t N = parser.get_N();
 	const uint64_t R = parser.get_R();
 
+	const std::string& output = parser.get_output();
+	if (output != "full") {
+		if (what == "rand_lab_free") {
+			generate::profile_flat_trees<
+				lal::graphs::free_tree,
+				lal::generate::rand_lab_free_trees>(output, n, N, R);
+		}
+		else if (what == "rand_lab_rooted") {
+			generate::profile_flat_trees<
+				lal::graphs::rooted_tree,
+				lal::generate::rand_lab_rooted_trees>(output, n, N, R);
+		}
+		return;
+	}
+
 	if (what == "all_lab_free") {
 		generate::profile_exhaustive_trees<
 			lal::graphs::free_tree,
@@ -266,6 +421,153 @@ void profile_random_arrangements(
 	output_execution_time_arrangements(total, n, R, T, N);
 }
 
+template <class tree_t>
+adjacency_lists get_adjacency_lists(const tree_t& t) noexcept
+{
+	const uint64_t n = t.get_num_nodes();
+	adjacency_lists adj(n);
+	for (lal::node u = 0; u < n; ++u) {
+		if constexpr (std::is_same_v<tree_t, lal::graphs::rooted_tree>) {
+			const auto& children = t.get_out_neighbors(u);
+			adj[u].assign(children.begin(), children.end());
+		}
+		else {
+			const auto& neighbors = t.get_neighbors(u);
+			adj[u].assign(neighbors.begin(), neighbors.end());
+		}
+	}
+	return adj;
+}
+
+template <class tree_t, class tree_rand_gen_t>
+void profile_parallel_exhaustive_arrangements(
+	const std::string& what,
+	const uint64_t n,
+	const uint64_t R,
+	const uint64_t T,
+	const uint64_t k,
+	const uint64_t max_threads
+) noexcept
+{
+	const auto enumerate = [&](const adjacency_lists& adj,
+							   const lal::node root,
+							   const int num_threads)
+	{
+		if (what == "all_arrangements") {
+			return enumerate_all_arrangements(n, k, num_threads);
+		}
+		if (what == "all_projective_arrangements") {
+			return enumerate_all_projective_arrangements(
+				adj, root, k, num_threads
+			);
+		}
+		return enumerate_all_planar_arrangements(adj, k, num_threads);
+	};
+	const auto known_total = [&](const adjacency_lists& adj, uint64_t& total)
+	{
+		if (what == "all_arrangements") {
+			return num_arrangements(n, total);
+		}
+		if (what == "all_projective_arrangements") {
+			return num_projective_arrangements(adj, total);
+		}
+		return num_planar_arrangements(adj, total);
+	};
+
+	// the same trees are used for every number of threads
+	std::vector<adjacency_lists> trees;
+	std::vector<lal::node> roots;
+	{
+		tree_rand_gen_t TreeGen(n, 1234);
+		for (uint64_t i = 0; i < T; ++i) {
+			const tree_t tree = TreeGen.get_tree();
+			trees.push_back(get_adjacency_lists(tree));
+			if constexpr (std::is_same_v<tree_t, lal::graphs::rooted_tree>) {
+				roots.push_back(tree.get_root());
+			}
+			else {
+				roots.push_back(0);
+			}
+		}
+	}
+
+	uint64_t expected = 0;
+	bool expected_fits = true;
+	for (const adjacency_lists& adj : trees) {
+		uint64_t total;
+		expected_fits = expected_fits and known_total(adj, total) and
+						not __builtin_mul_overflow(total, R, &total) and
+						not __builtin_add_overflow(expected, total, &expected);
+	}
+
+	std::vector<uint64_t> thread_counts;
+	for (uint64_t p = 1; p < max_threads; p *= 2) {
+		thread_counts.push_back(p);
+	}
+	thread_counts.push_back(max_threads);
+
+	std::cout << "n= " << n << '\n';
+	std::cout << "R= " << R << '\n';
+	std::cout << "T= " << T << '\n';
+	std::cout << "prefix= " << k << '\n';
+	if (expected_fits) {
+		std::cout << "Expected number of arrangements: " << expected << '\n';
+	}
+	else {
+		std::cout << "Expected number of arrangements: does not fit in 64 "
+					 "bits\n";
+	}
+
+	double time_one_thread = 0.0;
+	uint64_t checksum_one_thread = 0;
+
+	for (const uint64_t p : thread_counts) {
+		double total = 0.0;
+		uint64_t count = 0;
+		uint64_t checksum = 0;
+		uint64_t num_tasks = 0;
+
+		for (uint64_t r = 0; r < R; ++r) {
+			for (std::size_t i = 0; i < trees.size(); ++i) {
+				const auto begin = profiling::now();
+				const enumeration_result res =
+					enumerate(trees[i], roots[i], static_cast<int>(p));
+				const auto end = profiling::now();
+				total += profiling::elapsed_time(begin, end);
+
+				count += res.count;
+				checksum += res.checksum;
+				num_tasks += res.num_tasks;
+			}
+		}
+
+		if (p == 1) {
+			time_one_thread = total;
+			checksum_one_thread = checksum;
+		}
+
+		std::cout << "Threads: " << p << '\n';
+		std::cout << "    Total execution time: "
+				  << profiling::time_to_str(total) << '\n';
+		std::cout << "    Average tasks per tree: "
+				  << static_cast<double>(num_tasks) / static_cast<double>(R * T)
+				  << '\n';
+		std::cout << "    Arrangements: " << count << '\n';
+		std::cout << "    Arrangements/second: "
+				  << static_cast<double>(count) / (total / 1000.0) << '\n';
+		std::cout << "    Speedup: " << time_one_thread / total << '\n';
+
+		if (expected_fits and count != expected) {
+			std::cerr << "ERROR! Expected " << expected
+					  << " arrangements, enumerated " << count << '\n';
+		}
+		if (checksum != checksum_one_thread) {
+			std::cerr << "ERROR! The checksum differs from the one of the "
+						 "execution with 1 thread\n";
+		}
+	}
+}
+
 } // namespace generate
 
 void generate_arrangements(uint64_t argc, char *argv[]) noexcept
@@ -286,6 +588,27 @@ void generate_arrangements(uint64_t argc, char *argv[]) noexcept
 	const uint64_t T = parser.get_T();
 	const uint64_t N = parser.get_N();
 
+	if (parser.has_threads()) {
+		const uint64_t k = parser.get_prefix();
+		const uint64_t P = parser.get_threads();
+		if (what == "all_arrangements") {
+			generate::profile_parallel_exhaustive_arrangements<
+				lal::graphs::free_tree,
+				lal::generate::rand_ulab_free_trees>(what, n, R, T, k, P);
+		}
+		else if (what == "all_projective_arrangements") {
+			generate::profile_parallel_exhaustive_arrangements<
+				lal::graphs::rooted_tree,
+				lal::generate::rand_ulab_rooted_trees>(what, n, R, T, k, P);
+		}
+		else if (what == "all_planar_arrangements") {
+			generate::profile_parallel_exhaustive_arrangements<
+				lal::graphs::free_tree,
+				lal::generate::rand_ulab_free_trees>(what, n, R, T, k, P);
+		}
+		return;
+	}
+
 	if (what == "all_arrangements") {
 		generate::profile_exhaustive_arrangements<
 			lal::graphs::free_tree,
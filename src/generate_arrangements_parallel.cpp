@@ -0,0 +1,415 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "generate_arrangements_parallel.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <utility>
+
+// omp includes
+#include <omp.h>
+
+namespace profiling {
+namespace generate {
+
+namespace {
+
+[[nodiscard]] bool factorial(const uint64_t n, uint64_t& f) noexcept
+{
+	f = 1;
+	for (uint64_t i = 2; i <= n; ++i) {
+		if (__builtin_mul_overflow(f, i, &f)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * The intervals of a rooted tree.
+ *
+ * Every vertex u owns a segment that contains u and its children. The order
+ * of the elements in the segment is the relative order of u and the intervals
+ * of its children in a projective arrangement. When the root is placed first
+ * (planar arrangements) the segment of the root contains only its children.
+ *
+ * Enumerating all arrangements amounts to enumerating all the permutations
+ * of all segments, like an odometer whose digits are the segments.
+ */
+class rooted_intervals {
+public:
+
+	void init(
+		const adjacency_lists& adj,
+		const lal::node root,
+		const bool is_rooted,
+		const bool root_first
+	) noexcept
+	{
+		const std::size_t n = adj.size();
+		m_root = root;
+		m_root_first = root_first;
+
+		m_bfs.resize(n);
+		m_parent.assign(n, n);
+		m_begin.resize(n);
+		m_size.resize(n);
+		m_segments.resize(2 * n);
+
+		std::size_t head = 0;
+		std::size_t tail = 0;
+		std::size_t pos = 0;
+		m_bfs[tail++] = root;
+		while (head < tail) {
+			const lal::node u = m_bfs[head++];
+
+			m_begin[u] = pos;
+			if (not (root_first and u == root)) {
+				m_segments[pos++] = u;
+			}
+			for (const lal::node w : adj[u]) {
+				if (not is_rooted and w == m_parent[u]) {
+					continue;
+				}
+				m_parent[w] = u;
+				m_segments[pos++] = w;
+				m_bfs[tail++] = w;
+			}
+			m_size[u] = pos - m_begin[u];
+		}
+
+		sort_from(0);
+	}
+
+	[[nodiscard]] lal::node get_root() const noexcept
+	{
+		return m_root;
+	}
+
+	// Sets the segments of the vertices at BFS positions [s, n) to their
+	// first permutation.
+	void sort_from(const std::size_t s) noexcept
+	{
+		for (std::size_t i = s; i < m_bfs.size(); ++i) {
+			lal::node * const b = segment(m_bfs[i]);
+			std::sort(b, b + m_size[m_bfs[i]]);
+		}
+	}
+
+	// Advances the odometer made of the segments of the vertices at BFS
+	// positions [from, to). Returns false when all permutations have been
+	// visited, in which case all those segments are back to their first
+	// permutation.
+	[[nodiscard]] bool next(const std::size_t from, const std::size_t to)
+		noexcept
+	{
+		for (std::size_t i = from; i < to; ++i) {
+			lal::node * const b = segment(m_bfs[i]);
+			if (std::next_permutation(b, b + m_size[m_bfs[i]])) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Appends the segments of the vertices at BFS positions [0, s) to 'out'.
+	void store(const std::size_t s, std::vector<lal::node>& out) const noexcept
+	{
+		for (std::size_t i = 0; i < s; ++i) {
+			const lal::node u = m_bfs[i];
+			const lal::node * const b = &m_segments[m_begin[u]];
+			out.insert(out.end(), b, b + m_size[u]);
+		}
+	}
+
+	// Inverse of 'store'.
+	void load(const std::size_t s, const lal::node *in) noexcept
+	{
+		for (std::size_t i = 0; i < s; ++i) {
+			const lal::node u = m_bfs[i];
+			std::copy(in, in + m_size[u], segment(u));
+			in += m_size[u];
+		}
+	}
+
+	// Writes the arrangement given by the current permutations of the
+	// segments. 'inv' maps positions to vertices.
+	void layout(std::vector<lal::node>& inv) noexcept
+	{
+		std::size_t p = 0;
+		if (m_root_first) {
+			inv[p++] = m_root;
+		}
+
+		m_stack.clear();
+		m_stack.emplace_back(m_root, 0);
+		while (not m_stack.empty()) {
+			auto& [u, i] = m_stack.back();
+			if (i == m_size[u]) {
+				m_stack.pop_back();
+				continue;
+			}
+
+			const lal::node w = m_segments[m_begin[u] + i];
+			++i;
+			if (w == u) {
+				inv[p++] = u;
+			}
+			else {
+				m_stack.emplace_back(w, 0);
+			}
+		}
+	}
+
+private:
+
+	[[nodiscard]] lal::node *segment(const lal::node u) noexcept
+	{
+		return &m_segments[m_begin[u]];
+	}
+
+	lal::node m_root = 0;
+	bool m_root_first = false;
+
+	// vertices in BFS order from the root
+	std::vector<lal::node> m_bfs;
+	// parent of every vertex in the BFS
+	std::vector<lal::node> m_parent;
+	// start of every vertex's segment
+	std::vector<std::size_t> m_begin;
+	// size of every vertex's segment
+	std::vector<std::size_t> m_size;
+	// all segments
+	std::vector<lal::node> m_segments;
+	// stack used to lay out the arrangement
+	std::vector<std::pair<lal::node, std::size_t>> m_stack;
+};
+
+// A task of a tree class: the root and the permutations of the segments of
+// the first vertices in BFS order.
+struct interval_task {
+	lal::node root;
+	std::size_t offset;
+};
+
+enumeration_result enumerate_intervals(
+	const adjacency_lists& adj,
+	const std::vector<lal::node>& roots,
+	const bool is_rooted,
+	const bool root_first,
+	const uint64_t k,
+	const int num_threads
+) noexcept
+{
+	const std::size_t n = adj.size();
+	const std::size_t s = std::min<std::size_t>(k, n);
+
+	// build the tasks
+	std::vector<interval_task> tasks;
+	std::vector<lal::node> fixed;
+	{
+		rooted_intervals I;
+		for (const lal::node r : roots) {
+			I.init(adj, r, is_rooted, root_first);
+			do {
+				tasks.push_back({r, fixed.size()});
+				I.store(s, fixed);
+			}
+			while (I.next(0, s));
+		}
+	}
+
+	enumeration_result res;
+	res.num_tasks = tasks.size();
+
+	uint64_t count = 0;
+	uint64_t checksum = 0;
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		rooted_intervals I;
+		bool initialized = false;
+		std::vector<lal::node> inv(n);
+
+#pragma omp for schedule(dynamic, 1) reduction(+ : count, checksum)
+		for (std::size_t t = 0; t < tasks.size(); ++t) {
+			if (not initialized or I.get_root() != tasks[t].root) {
+				I.init(adj, tasks[t].root, is_rooted, root_first);
+				initialized = true;
+			}
+			I.load(s, fixed.data() + tasks[t].offset);
+			I.sort_from(s);
+
+			do {
+				I.layout(inv);
+				++count;
+				checksum += inv[0];
+			}
+			while (I.next(s, n));
+		}
+	}
+
+	res.count = count;
+	res.checksum = checksum;
+	return res;
+}
+
+} // namespace
+
+enumeration_result enumerate_all_arrangements(
+	const uint64_t n, const uint64_t k, const int num_threads
+) noexcept
+{
+	const std::size_t s = std::min<std::size_t>(k, n);
+
+	// all the prefixes of length s
+	std::vector<lal::node> prefixes;
+	{
+		std::vector<lal::node> cur(s);
+		std::vector<char> used(n, 0);
+		const auto make_prefixes =
+			[&](const auto& self, const std::size_t i) -> void
+		{
+			if (i == s) {
+				prefixes.insert(prefixes.end(), cur.begin(), cur.end());
+				return;
+			}
+			for (lal::node u = 0; u < n; ++u) {
+				if (not used[u]) {
+					used[u] = 1;
+					cur[i] = u;
+					self(self, i + 1);
+					used[u] = 0;
+				}
+			}
+		};
+		make_prefixes(make_prefixes, 0);
+	}
+
+	enumeration_result res;
+	res.num_tasks = (s == 0 ? 1 : prefixes.size() / s);
+
+	uint64_t count = 0;
+	uint64_t checksum = 0;
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		std::vector<lal::node> inv(n);
+		std::vector<char> in_prefix(n);
+
+#pragma omp for schedule(dynamic, 1) reduction(+ : count, checksum)
+		for (std::size_t t = 0; t < res.num_tasks; ++t) {
+			std::fill(in_prefix.begin(), in_prefix.end(), 0);
+			for (std::size_t i = 0; i < s; ++i) {
+				inv[i] = prefixes[t * s + i];
+				in_prefix[inv[i]] = 1;
+			}
+			std::size_t p = s;
+			for (lal::node u = 0; u < n; ++u) {
+				if (not in_prefix[u]) {
+					inv[p++] = u;
+				}
+			}
+
+			do {
+				++count;
+				checksum += inv[0];
+			}
+			while (std::next_permutation(inv.data() + s, inv.data() + n));
+		}
+	}
+
+	res.count = count;
+	res.checksum = checksum;
+	return res;
+}
+
+enumeration_result enumerate_all_projective_arrangements(
+	const adjacency_lists& children,
+	const lal::node root,
+	const uint64_t k,
+	const int num_threads
+) noexcept
+{
+	return enumerate_intervals(children, {root}, true, false, k, num_threads);
+}
+
+enumeration_result enumerate_all_planar_arrangements(
+	const adjacency_lists& neighbors, const uint64_t k, const int num_threads
+) noexcept
+{
+	std::vector<lal::node> roots(neighbors.size());
+	for (lal::node u = 0; u < roots.size(); ++u) {
+		roots[u] = u;
+	}
+	return enumerate_intervals(neighbors, roots, false, true, k, num_threads);
+}
+
+bool num_arrangements(const uint64_t n, uint64_t& total) noexcept
+{
+	return factorial(n, total);
+}
+
+bool num_projective_arrangements(
+	const adjacency_lists& children, uint64_t& total
+) noexcept
+{
+	// product of (k_u + 1)! where k_u is the number of children of u
+	total = 1;
+	for (const auto& c : children) {
+		uint64_t f;
+		if (not factorial(c.size() + 1, f)) {
+			return false;
+		}
+		if (__builtin_mul_overflow(total, f, &total)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool num_planar_arrangements(
+	const adjacency_lists& neighbors, uint64_t& total
+) noexcept
+{
+	// n times the product of d_u! where d_u is the degree of u
+	total = neighbors.size();
+	for (const auto& N : neighbors) {
+		uint64_t f;
+		if (not factorial(N.size(), f)) {
+			return false;
+		}
+		if (__builtin_mul_overflow(total, f, &total)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace generate
+} // namespace profiling
@@ -0,0 +1,103 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <vector>
+
+// lal includes
+#include <lal/basic_types.hpp>
+
+namespace profiling {
+namespace generate {
+
+// Adjacency lists of a tree. For rooted trees, only the children of every
+// vertex are stored.
+typedef std::vector<std::vector<lal::node>> adjacency_lists;
+
+// Result of an exhaustive enumeration.
+struct enumeration_result {
+	// number of arrangements enumerated
+	uint64_t count = 0;
+	// sum of the vertices placed at the leftmost position of every
+	// arrangement, used to check that all runs visit the same arrangements
+	uint64_t checksum = 0;
+	// number of independent tasks the space was split into
+	uint64_t num_tasks = 0;
+};
+
+/*
+ * The following functions enumerate all the arrangements of a class in
+ * parallel. The space is split into independent tasks that are handed out
+ * to the threads dynamically, so that threads that finish early take the
+ * remaining tasks.
+ *
+ * For unconstrained arrangements, each task fixes the vertices at the first
+ * @e k positions. For projective and planar arrangements, each task fixes the
+ * relative order of the intervals of the first @e k vertices in a BFS
+ * traversal from the root (in planar arrangements every vertex is, in turn,
+ * the root, placed at the leftmost position).
+ */
+
+// Enumerates all n! arrangements of n vertices.
+[[nodiscard]] enumeration_result enumerate_all_arrangements(
+	const uint64_t n, const uint64_t k, const int num_threads
+) noexcept;
+
+// Enumerates all projective arrangements of a rooted tree.
+[[nodiscard]] enumeration_result enumerate_all_projective_arrangements(
+	const adjacency_lists& children,
+	const lal::node root,
+	const uint64_t k,
+	const int num_threads
+) noexcept;
+
+// Enumerates all planar arrangements of a free tree.
+[[nodiscard]] enumeration_result enumerate_all_planar_arrangements(
+	const adjacency_lists& neighbors, const uint64_t k, const int num_threads
+) noexcept;
+
+/*
+ * Known number of arrangements of each class. These functions return false
+ * when the number does not fit in 64 bits.
+ */
+
+[[nodiscard]] bool
+num_arrangements(const uint64_t n, uint64_t& total) noexcept;
+
+[[nodiscard]] bool num_projective_arrangements(
+	const adjacency_lists& children, uint64_t& total
+) noexcept;
+
+[[nodiscard]] bool num_planar_arrangements(
+	const adjacency_lists& neighbors, uint64_t& total
+) noexcept;
+
+} // namespace generate
+} // namespace profiling
@@ -58,6 +58,18 @@ void generate_arrangements_pp::print_usage() const noexcept
 	std::cout << "          Indicate the number of replicas (times to replicate an\n";
 	std::cout << "          execution).\n";
 	std::cout << '\n';
+	std::cout << "    [?]   -threads P\n";
+	std::cout << "          Enumerate the exhaustive classes in parallel with 1, 2, 4, ...\n";
+	std::cout << "          up to P threads. The whole class is enumerated ('-N' is\n";
+	std::cout << "          ignored) and the number of arrangements is checked against\n";
+	std::cout << "          the known total.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -prefix k\n";
+	std::cout << "          Indicate the number of positions (vertices, for projective\n";
+	std::cout << "          and planar arrangements) that are fixed in every task of the\n";
+	std::cout << "          parallel enumeration.\n";
+	std::cout << "          Default: 2\n";
+	std::cout << '\n';
 	std::cout << "    [*]   -class C\n";
 	std::cout << "          Indicate the class of generation to profile. The available\n";
 	std::cout << "          classes are the following:\n";
@@ -103,6 +115,15 @@ int generate_arrangements_pp::parse_params() noexcept
 			m_has_R = true;
 			++i;
 		}
+		else if (param == "-threads") {
+			m_threads = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_has_threads = true;
+			++i;
+		}
+		else if (param == "-prefix") {
+			m_prefix = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			++i;
+		}
 		else if (param == "-class") {
 			m_gen_class = std::string(m_argv[i + 1]);
 			++i;
@@ -138,6 +159,17 @@ int generate_arrangements_pp::check_errors() const noexcept
 		std::cout << "Error: missing parameter '-class'.\n";
 		return 1;
 	}
+	if (m_has_threads) {
+		if (m_threads == 0) {
+			std::cout << "Error: the number of threads must be positive.\n";
+			return 1;
+		}
+		if (not m_gen_class.starts_with("all_")) {
+			std::cout << "Error: parameter '-threads' is only valid for the\n";
+			std::cout << "    exhaustive classes.\n";
+			return 1;
+		}
+	}
 
 	return 0;
 }
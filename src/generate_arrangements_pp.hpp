@@ -64,6 +64,18 @@ public:
 	{
 		return m_R;
 	}
+	[[nodiscard]] bool has_threads() const noexcept
+	{
+		return m_has_threads;
+	}
+	[[nodiscard]] uint64_t get_threads() const noexcept
+	{
+		return m_threads;
+	}
+	[[nodiscard]] uint64_t get_prefix() const noexcept
+	{
+		return m_prefix;
+	}
 
 	void print_usage() const noexcept;
 
@@ -94,6 +106,13 @@ private:
 	uint64_t m_R = 0;
 	bool m_has_R = false;
 
+	// maximum number of threads for the parallel enumeration
+	uint64_t m_threads = 0;
+	bool m_has_threads = false;
+
+	// length of the prefix that defines the tasks of the parallel enumeration
+	uint64_t m_prefix = 2;
+
 	uint64_t m_argc;
 	char **m_argv;
 
@@ -0,0 +1,59 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "generate_complete_graphs.hpp"
+
+namespace profiling {
+namespace generate {
+
+lal::graphs::undirected_graph complete_graph(const uint64_t n) noexcept
+{
+	lal::graphs::undirected_graph g(n);
+	for (lal::node u = 0; u < n; ++u) {
+		for (lal::node v = u + 1; v < n; ++v) {
+			g.add_edge_bulk(u, v);
+		}
+	}
+	g.finish_bulk_add(true, false);
+	return g;
+}
+
+lal::graphs::undirected_graph
+complete_bipartite_graph(const uint64_t n1, const uint64_t n2) noexcept
+{
+	lal::graphs::undirected_graph g(n1 + n2);
+	for (lal::node u = 0; u < n1; ++u) {
+		for (lal::node v = n1; v < n1 + n2; ++v) {
+			g.add_edge_bulk(u, v);
+		}
+	}
+	g.finish_bulk_add(true, false);
+	return g;
+}
+
+} // namespace generate
+} // namespace profiling
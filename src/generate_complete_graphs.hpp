@@ -0,0 +1,49 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+
+// lal includes
+#include <lal/graphs/undirected_graph.hpp>
+
+namespace profiling {
+namespace generate {
+
+// The complete graph K_n.
+[[nodiscard]] lal::graphs::undirected_graph complete_graph(const uint64_t n)
+	noexcept;
+
+// The complete bipartite graph K_{n1,n2}. Vertices [0,n1) form one part and
+// vertices [n1,n1+n2) form the other.
+[[nodiscard]] lal::graphs::undirected_graph
+complete_bipartite_graph(const uint64_t n1, const uint64_t n2) noexcept;
+
+} // namespace generate
+} // namespace profiling
@@ -0,0 +1,133 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "generate_head_vectors.hpp"
+
+// C++ includes
+#include <algorithm>
+
+namespace profiling {
+namespace generate {
+
+rand_lab_head_vectors::rand_lab_head_vectors(
+	const uint64_t n, const uint64_t seed, const bool rooted
+) noexcept
+	: m_n(n),
+	  m_rooted(rooted),
+	  m_gen(seed),
+	  m_unif(0, n == 0 ? 0 : n - 1),
+	  m_Prufer(n <= 2 ? 0 : n - 2),
+	  m_degree(n),
+	  m_parent(n)
+{ }
+
+void rand_lab_head_vectors::get_Prufer_sequence(uint64_t * const out) noexcept
+{
+	for (uint64_t i = 0; i + 2 < m_n; ++i) {
+		out[i] = m_unif(m_gen);
+	}
+}
+
+void rand_lab_head_vectors::get_head_vector(uint64_t * const out) noexcept
+{
+	if (m_n == 1) {
+		out[0] = 0;
+		return;
+	}
+
+	get_Prufer_sequence(m_Prufer.data());
+	decode_head_vector(out);
+}
+
+void rand_lab_head_vectors::get_head_vector(
+	const uint64_t * const in, uint64_t * const out
+) noexcept
+{
+	if (m_n == 1) {
+		out[0] = 0;
+		return;
+	}
+
+	std::copy(in, in + m_Prufer.size(), m_Prufer.begin());
+	decode_head_vector(out);
+}
+
+void rand_lab_head_vectors::decode_head_vector(uint64_t * const out) noexcept
+{
+	decode();
+
+	// re-orient the path from the new root to vertex n - 1
+	const uint64_t root = m_rooted ? m_unif(m_gen) : 0;
+	uint64_t prev = m_n;
+	uint64_t u = root;
+	while (u != m_n) {
+		const uint64_t next = m_parent[u];
+		m_parent[u] = prev;
+		prev = u;
+		u = next;
+	}
+
+	for (uint64_t v = 0; v < m_n; ++v) {
+		out[v] = (m_parent[v] == m_n ? 0 : m_parent[v] + 1);
+	}
+}
+
+void rand_lab_head_vectors::decode() noexcept
+{
+	// linear-time decoding of the Prüfer sequence
+	std::fill(m_degree.begin(), m_degree.end(), 1);
+	for (const uint64_t v : m_Prufer) {
+		++m_degree[v];
+	}
+
+	uint64_t ptr = 0;
+	while (m_degree[ptr] != 1) {
+		++ptr;
+	}
+	uint64_t leaf = ptr;
+
+	for (const uint64_t v : m_Prufer) {
+		m_parent[leaf] = v;
+		--m_degree[v];
+		if (v < ptr and m_degree[v] == 1) {
+			leaf = v;
+		}
+		else {
+			++ptr;
+			while (m_degree[ptr] != 1) {
+				++ptr;
+			}
+			leaf = ptr;
+		}
+	}
+
+	m_parent[leaf] = m_n - 1;
+	m_parent[m_n - 1] = m_n;
+}
+
+} // namespace generate
+} // namespace profiling
@@ -0,0 +1,90 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace profiling {
+namespace generate {
+
+/*
+ * Generation of uniformly random labelled trees that never builds a graph.
+ *
+ * Trees are produced as Prüfer sequences (of length n - 2) or as head vectors
+ * (of length n) written directly into a buffer owned by the caller. All the
+ * memory needed is allocated once, at construction.
+ *
+ * For free trees, the head vector is rooted at vertex 0, as in
+ * lal::graphs::free_tree::get_head_vector(). For rooted trees, the root is
+ * chosen uniformly at random, as in lal::generate::rand_lab_rooted_trees.
+ */
+class rand_lab_head_vectors {
+public:
+
+	rand_lab_head_vectors(
+		const uint64_t n, const uint64_t seed, const bool rooted
+	) noexcept;
+	~rand_lab_head_vectors() noexcept = default;
+
+	// Writes a random Prüfer sequence into out[0, n - 2).
+	void get_Prufer_sequence(uint64_t * const out) noexcept;
+
+	// Writes the head vector of a random tree into out[0, n).
+	void get_head_vector(uint64_t * const out) noexcept;
+
+	// Writes into out[0, n) the head vector of the tree whose Prüfer sequence
+	// is in[0, n - 2), rooted as in get_head_vector().
+	void get_head_vector(const uint64_t * const in, uint64_t * const out)
+		noexcept;
+
+private:
+
+	// Decodes the sequence in 'm_Prufer' into 'm_parent'. The resulting tree
+	// is oriented towards vertex n - 1.
+	void decode() noexcept;
+
+	// Decodes the sequence in 'm_Prufer' and writes the head vector of the
+	// resulting tree into out[0, n).
+	void decode_head_vector(uint64_t * const out) noexcept;
+
+	const uint64_t m_n;
+	const bool m_rooted;
+
+	std::mt19937_64 m_gen;
+	std::uniform_int_distribution<uint64_t> m_unif;
+
+	std::vector<uint64_t> m_Prufer;
+	std::vector<uint64_t> m_degree;
+	std::vector<uint64_t> m_parent;
+};
+
+} // namespace generate
+} // namespace profiling
@@ -0,0 +1,158 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "generate_tree_shapes.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+
+namespace profiling {
+namespace generate {
+
+tree_shape_head_vectors::tree_shape_head_vectors(
+	const uint64_t n, const tree_shape& shape, const uint64_t seed
+) noexcept
+	: m_n(n),
+	  m_family(shape.family),
+	  m_gen(seed),
+	  m_decoder(n, seed, false)
+{
+	const uint64_t k = static_cast<uint64_t>(shape.parameter);
+	if (m_family == "caterpillar" or m_family == "broom") {
+		m_k = std::clamp<uint64_t>(
+			k > 0 ? k : n / 2, 1, std::max<uint64_t>(n, 1)
+		);
+	}
+	else if (m_family == "spider") {
+		m_k = std::clamp<uint64_t>(
+			k > 0 ? k : 3, 1, std::max<uint64_t>(n, 2) - 1
+		);
+	}
+	else if (m_family == "kary") {
+		m_k = k > 0 ? k : 2;
+	}
+	else if (m_family == "degree" and n >= 2) {
+		const double gamma = shape.parameter > 0 ? shape.parameter : 2.5;
+
+		// probability of degree d + 1, for d in [0, n - 1)
+		std::vector<double> weights(n - 1);
+		for (uint64_t d = 0; d + 1 < n; ++d) {
+			weights[d] = std::pow(static_cast<double>(d + 1), -gamma);
+		}
+		m_degree_distribution = std::discrete_distribution<uint64_t>(
+			weights.begin(), weights.end()
+		);
+		m_degree.resize(n);
+		m_Prufer.reserve(n - 2);
+	}
+}
+
+void tree_shape_head_vectors::get_head_vector(lal::head_vector& hv) noexcept
+{
+	const uint64_t n = m_n;
+	hv.resize(n);
+	if (n == 0) {
+		return;
+	}
+	hv[0] = 0;
+
+	// the entries are the parents plus one
+	if (m_family == "path") {
+		for (lal::node u = 1; u < n; ++u) {
+			hv[u] = u;
+		}
+	}
+	else if (m_family == "star") {
+		std::fill(hv.begin() + 1, hv.end(), 1);
+	}
+	else if (m_family == "caterpillar") {
+		for (lal::node u = 1; u < n; ++u) {
+			hv[u] = u < m_k ? u : (u - m_k) % m_k + 1;
+		}
+	}
+	else if (m_family == "spider") {
+		for (lal::node u = 1; u < n; ++u) {
+			hv[u] = u <= m_k ? 1 : u - m_k + 1;
+		}
+	}
+	else if (m_family == "kary") {
+		for (lal::node u = 1; u < n; ++u) {
+			hv[u] = (u - 1) / m_k + 1;
+		}
+	}
+	else if (m_family == "broom") {
+		for (lal::node u = 1; u < n; ++u) {
+			hv[u] = u < m_k ? u : m_k;
+		}
+	}
+	else if (m_family == "degree") {
+		if (n == 1) {
+			return;
+		}
+		draw_degree_sequence();
+		m_Prufer.clear();
+		for (lal::node u = 0; u < n; ++u) {
+			m_Prufer.insert(m_Prufer.end(), m_degree[u] - 1, u);
+		}
+		std::shuffle(m_Prufer.begin(), m_Prufer.end(), m_gen);
+		m_decoder.get_head_vector(m_Prufer.data(), hv.data());
+	}
+}
+
+void tree_shape_head_vectors::draw_degree_sequence() noexcept
+{
+	const uint64_t n = m_n;
+	const uint64_t target = n - 2;
+
+	// the degrees minus one must add up to n - 2
+	uint64_t extra = 0;
+	for (lal::node u = 0; u < n; ++u) {
+		m_degree[u] = m_degree_distribution(m_gen) + 1;
+		extra += m_degree[u] - 1;
+	}
+
+	// redraw the degree of random vertices, keeping only the new degrees
+	// that bring the sum closer to the target
+	const auto distance = [=](const uint64_t x)
+	{
+		return x < target ? target - x : x - target;
+	};
+	std::uniform_int_distribution<lal::node> V(0, n - 1);
+	while (extra != target) {
+		const lal::node u = V(m_gen);
+		const uint64_t d = m_degree_distribution(m_gen) + 1;
+		const uint64_t new_extra = extra - m_degree[u] + d;
+		if (distance(new_extra) < distance(extra)) {
+			m_degree[u] = d;
+			extra = new_extra;
+		}
+	}
+}
+
+} // namespace generate
+} // namespace profiling
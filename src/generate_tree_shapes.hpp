@@ -0,0 +1,171 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// lal includes
+#include <lal/basic_types.hpp>
+#include <lal/generate/tree_generator_type.hpp>
+#include <lal/graphs/conversions.hpp>
+#include <lal/graphs/free_tree.hpp>
+#include <lal/graphs/rooted_tree.hpp>
+
+// common includes
+#include "generate_head_vectors.hpp"
+#include "tree_shape.hpp"
+
+namespace profiling {
+namespace generate {
+
+/*
+ * Head vectors of trees of a given shape, rooted at vertex 0.
+ *
+ * All families except 'random' are written directly into the head vector in
+ * linear time. Vertex 0 is an end of paths, brooms and the spine of
+ * caterpillars, the centre of stars and spiders, and the root of k-ary trees,
+ * and the parent of every other vertex has a smaller label. All families
+ * except 'degree' give the same tree in every call. In family 'degree', the
+ * degree of every vertex is drawn from a power law, the degrees are adjusted
+ * to add up to 2(n - 1), and the tree is a uniformly random labelled tree
+ * with that degree sequence, decoded from a random Prüfer sequence in which
+ * every vertex u appears deg(u) - 1 times.
+ */
+class tree_shape_head_vectors {
+public:
+
+	tree_shape_head_vectors(
+		const uint64_t n, const tree_shape& shape, const uint64_t seed
+	) noexcept;
+	~tree_shape_head_vectors() noexcept = default;
+
+	// Writes the head vector of a tree of the shape into hv[0, n).
+	void get_head_vector(lal::head_vector& hv) noexcept;
+
+private:
+
+	// Draws the degree sequence of family 'degree' into 'm_degree'.
+	void draw_degree_sequence() noexcept;
+
+	const uint64_t m_n;
+	const std::string m_family;
+	// integer parameter of the family
+	uint64_t m_k = 0;
+
+	std::mt19937_64 m_gen;
+	std::discrete_distribution<uint64_t> m_degree_distribution;
+	std::vector<uint64_t> m_degree;
+	std::vector<uint64_t> m_Prufer;
+	rand_lab_head_vectors m_decoder;
+};
+
+/*
+ * Generator of trees of a given shape, with the interface of LAL's
+ * generators. Shape 'random' uses LAL's generator of uniformly random
+ * unlabelled trees with the same seed, so that the profilers see the same
+ * trees as without option '-shape'. The post-processing actions of the
+ * other shapes are those of LAL's generators: normalise the tree, calculate
+ * its type and, for rooted trees, the sizes of its subtrees.
+ */
+template <class tree_t>
+class tree_shape_generator {
+public:
+
+	static constexpr bool is_rooted =
+		std::is_same_v<lal::graphs::rooted_tree, tree_t>;
+
+	tree_shape_generator(
+		const uint64_t n, const tree_shape& shape, const uint64_t seed
+	) noexcept
+		: m_hv_gen(n, shape, seed),
+		  m_hv(n)
+	{
+		if (shape.family == "random") {
+			m_random.emplace(n, seed);
+		}
+	}
+
+	void deactivate_all_postprocessing_actions() noexcept
+	{
+		if (m_random.has_value()) {
+			m_random->deactivate_all_postprocessing_actions();
+		}
+		m_postprocess = false;
+	}
+
+	[[nodiscard]] tree_t get_tree() noexcept
+	{
+		if (m_random.has_value()) {
+			return m_random->get_tree();
+		}
+
+		m_hv_gen.get_head_vector(m_hv);
+		tree_t t = [&]()
+		{
+			if constexpr (is_rooted) {
+				return lal::graphs::from_head_vector_to_rooted_tree(
+					m_hv, m_postprocess, false
+				);
+			}
+			else {
+				return lal::graphs::from_head_vector_to_free_tree(
+						   m_hv, m_postprocess, false
+				)
+					.first;
+			}
+		}();
+		if (m_postprocess) {
+			t.calculate_tree_type();
+			if constexpr (is_rooted) {
+				t.calculate_size_subtrees();
+			}
+		}
+		return t;
+	}
+
+private:
+
+	std::optional<lal::generate::tree_generator_type_t<
+		lal::generate::random_t,
+		lal::generate::unlabelled_t,
+		tree_t>>
+		m_random;
+
+	tree_shape_head_vectors m_hv_gen;
+	lal::head_vector m_hv;
+	bool m_postprocess = true;
+};
+
+} // namespace generate
+} // namespace profiling
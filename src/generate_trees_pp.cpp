@@ -46,7 +46,7 @@ void generate_trees_pp::print_usage() const noexcept
 	std::cout << "    Those marked with [?] are optional.\n";
 	std::cout << '\n';
 	std::cout << "    [*]   -n n\n";
-	std::cout << "          Indicate the number of vertices of the trees.\n";
+	std::cout << "          Indicate the number of vertices of the trees (at least 1).\n";
 	std::cout << '\n';
 	std::cout << "    [*]   -N N\n";
 	std::cout << "          Indicate the number of trees to generate.\n";
@@ -63,6 +63,18 @@ void generate_trees_pp::print_usage() const noexcept
 	std::cout << "          " << algo << '\n';
 	}
 	std::cout << '\n';
+	std::cout << "    [?]   -output O\n";
+	std::cout << "          Indicate what the generator produces:\n";
+	std::cout << "              full: full tree objects\n";
+	std::cout << "              head_vector: head vectors written into a flat\n";
+	std::cout << "                  buffer, without building the tree\n";
+	std::cout << "              Prufer: Prüfer sequences written into a flat\n";
+	std::cout << "                  buffer\n";
+	std::cout << "              compare: all of the above, reporting trees/second\n";
+	std::cout << "          The last three are only available for the classes\n";
+	std::cout << "          rand_lab_free and rand_lab_rooted.\n";
+	std::cout << "          Default: full\n";
+	std::cout << '\n';
 	// clang-format on
 }
 
@@ -95,6 +107,10 @@ int generate_trees_pp::parse_params() noexcept
 			m_has_R = true;
 			++i;
 		}
+		else if (param == "-output") {
+			m_output = std::string(m_argv[i + 1]);
+			++i;
+		}
 		else if (param == "-class") {
 			m_gen_class = std::string(m_argv[i + 1]);
 			++i;
@@ -114,6 +130,10 @@ int generate_trees_pp::check_errors() const noexcept
 		std::cout << "Error: missing parameter '-n'.\n";
 		return 1;
 	}
+	if (m_n < 1) {
+		std::cout << "Error: the trees must have at least one vertex.\n";
+		return 1;
+	}
 	if (not m_has_N) {
 		std::cout << "Error: missing parameter '-N'.\n";
 		return 1;
@@ -126,6 +146,17 @@ int generate_trees_pp::check_errors() const noexcept
 		std::cout << "Error: missing parameter '-class'.\n";
 		return 1;
 	}
+	if (not m_allowed_outputs.contains(m_output)) {
+		std::cout << "Error: wrong value for parameter '-output'.\n";
+		std::cout << "    Value: '" << m_output << "'\n";
+		return 1;
+	}
+	if (m_output != "full" and m_gen_class != "rand_lab_free" and
+		m_gen_class != "rand_lab_rooted") {
+		std::cout << "Error: output '" << m_output << "' is only available\n";
+		std::cout << "    for the classes rand_lab_free and rand_lab_rooted.\n";
+		return 1;
+	}
 
 	return 0;
 }
@@ -61,6 +61,10 @@ public:
 	{
 		return m_R;
 	}
+	[[nodiscard]] const std::string& get_output() const noexcept
+	{
+		return m_output;
+	}
 
 	void print_usage() const noexcept;
 
@@ -90,6 +94,9 @@ private:
 	uint64_t m_R = 0;
 	bool m_has_R = false;
 
+	// what the generator produces
+	std::string m_output = "full";
+
 	const std::set<std::string> m_allowed_gen_classes = std::set<std::string>({
 		"all_lab_free",
 		"all_lab_rooted",
@@ -100,6 +107,12 @@ private:
 		"rand_ulab_free",
 		"rand_ulab_rooted",
 	});
+	const std::set<std::string> m_allowed_outputs = std::set<std::string>({
+		"full",
+		"head_vector",
+		"Prufer",
+		"compare",
+	});
 	uint64_t m_argc;
 	char **m_argv;
 };
@@ -0,0 +1,250 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "gmp_memory.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// C includes
+#include <gmp.h>
+
+namespace profiling {
+namespace gmp_memory {
+
+namespace {
+
+typedef void *(*alloc_func_t)(std::size_t);
+typedef void *(*realloc_func_t)(void *, std::size_t, std::size_t);
+typedef void (*free_func_t)(void *, std::size_t);
+
+// memory functions GMP had before installing ours
+alloc_func_t previous_alloc = nullptr;
+realloc_func_t previous_realloc = nullptr;
+free_func_t previous_free = nullptr;
+
+// counters are per thread so that counting does not add contention
+thread_local counters thread_counters;
+
+void *counting_alloc(const std::size_t size)
+{
+	++thread_counters.allocations;
+	thread_counters.bytes += size;
+	return previous_alloc(size);
+}
+
+void *counting_realloc(
+	void *ptr, const std::size_t old_size, const std::size_t new_size
+)
+{
+	++thread_counters.reallocations;
+	if (new_size > old_size) {
+		thread_counters.bytes += new_size - old_size;
+	}
+	return previous_realloc(ptr, old_size, new_size);
+}
+
+void counting_free(void *ptr, const std::size_t size)
+{
+	++thread_counters.frees;
+	previous_free(ptr, size);
+}
+
+// alignment of the blocks of the arena
+constexpr std::size_t arena_alignment = 16;
+// minimum size of the chunks of the arena
+constexpr std::size_t arena_chunk_size = 1 << 20;
+
+// Bump allocator of a thread. Chunks are kept until the thread finishes.
+struct arena {
+	struct chunk {
+		char *data;
+		std::size_t size;
+	};
+
+	~arena() noexcept
+	{
+		for (const chunk& c : chunks) {
+			std::free(c.data);
+		}
+	}
+
+	[[nodiscard]] bool owns(const void *ptr) const noexcept
+	{
+		const auto p = reinterpret_cast<std::uintptr_t>(ptr);
+		for (const chunk& c : chunks) {
+			const auto b = reinterpret_cast<std::uintptr_t>(c.data);
+			if (b <= p and p < b + c.size) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	[[nodiscard]] void *allocate(std::size_t size) noexcept
+	{
+		size = (size + arena_alignment - 1) & ~(arena_alignment - 1);
+
+		while (current < chunks.size() and
+			   used + size > chunks[current].size) {
+			++current;
+			used = 0;
+		}
+		if (current == chunks.size()) {
+			const std::size_t s = std::max(size, arena_chunk_size);
+			chunks.push_back({static_cast<char *>(std::malloc(s)), s});
+			used = 0;
+		}
+
+		char * const p = chunks[current].data + used;
+		used += size;
+		last = p;
+		return p;
+	}
+
+	// Tries to resize the last block allocated. Returns false if the block
+	// does not fit in its chunk.
+	[[nodiscard]] bool
+	extend(const void *ptr, const std::size_t new_size) noexcept
+	{
+		if (ptr != last) {
+			return false;
+		}
+		const std::size_t begin =
+			static_cast<std::size_t>(last - chunks[current].data);
+		const std::size_t size =
+			(new_size + arena_alignment - 1) & ~(arena_alignment - 1);
+		if (begin + size > chunks[current].size) {
+			return false;
+		}
+		used = begin + size;
+		return true;
+	}
+
+	void reset() noexcept
+	{
+		current = 0;
+		used = 0;
+		last = nullptr;
+	}
+
+	std::vector<chunk> chunks;
+	// chunk where blocks are allocated
+	std::size_t current = 0;
+	// bytes used in the current chunk
+	std::size_t used = 0;
+	// last block allocated
+	char *last = nullptr;
+	// is there an arena_scope alive?
+	bool active = false;
+};
+
+thread_local arena thread_arena;
+
+void *arena_alloc(const std::size_t size)
+{
+	if (not thread_arena.active) {
+		return previous_alloc(size);
+	}
+	return thread_arena.allocate(size);
+}
+
+void *arena_realloc(
+	void *ptr, const std::size_t old_size, const std::size_t new_size
+)
+{
+	if (not thread_arena.owns(ptr)) {
+		if (not thread_arena.active) {
+			return previous_realloc(ptr, old_size, new_size);
+		}
+		void * const p = thread_arena.allocate(new_size);
+		std::memcpy(p, ptr, std::min(old_size, new_size));
+		previous_free(ptr, old_size);
+		return p;
+	}
+
+	if (new_size <= old_size or thread_arena.extend(ptr, new_size)) {
+		return ptr;
+	}
+	void * const p = arena_alloc(new_size);
+	std::memcpy(p, ptr, old_size);
+	return p;
+}
+
+void arena_free(void *ptr, const std::size_t size)
+{
+	if (not thread_arena.owns(ptr)) {
+		previous_free(ptr, size);
+	}
+}
+
+} // namespace
+
+void install_counting() noexcept
+{
+	mp_get_memory_functions(&previous_alloc, &previous_realloc, &previous_free);
+	mp_set_memory_functions(counting_alloc, counting_realloc, counting_free);
+}
+
+void install_arena() noexcept
+{
+	mp_get_memory_functions(&previous_alloc, &previous_realloc, &previous_free);
+	mp_set_memory_functions(arena_alloc, arena_realloc, arena_free);
+}
+
+void uninstall() noexcept
+{
+	mp_set_memory_functions(previous_alloc, previous_realloc, previous_free);
+}
+
+counters get_counters() noexcept
+{
+	return thread_counters;
+}
+
+void reset_counters() noexcept
+{
+	thread_counters = counters{};
+}
+
+arena_scope::arena_scope() noexcept
+{
+	thread_arena.active = true;
+}
+
+arena_scope::~arena_scope() noexcept
+{
+	thread_arena.active = false;
+	thread_arena.reset();
+}
+
+} // namespace gmp_memory
+} // namespace profiling
@@ -0,0 +1,90 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+
+namespace profiling {
+namespace gmp_memory {
+
+/*
+ * Memory functions of GMP.
+ *
+ * The functions below replace GMP's memory functions (see
+ * mp_set_memory_functions) so that the memory used by lal::numeric::integer
+ * and lal::numeric::rational can be accounted for, or allocated from an
+ * arena. Only one set of functions can be installed at a time.
+ */
+
+// Memory operations made by GMP since the last call to reset_counters().
+struct counters {
+	uint64_t allocations = 0;
+	uint64_t reallocations = 0;
+	uint64_t frees = 0;
+	uint64_t bytes = 0;
+};
+
+// Makes GMP count every allocation, reallocation and free.
+void install_counting() noexcept;
+
+// Makes GMP allocate from a per-thread arena in the threads that have an
+// arena_scope alive. Other threads use the previous functions.
+void install_arena() noexcept;
+
+// Restores the memory functions GMP had before the last install.
+void uninstall() noexcept;
+
+// Returns the counters of the calling thread.
+[[nodiscard]] counters get_counters() noexcept;
+
+// Sets the counters of the calling thread to zero.
+void reset_counters() noexcept;
+
+/*
+ * Scope of the arena of the calling thread.
+ *
+ * While an object of this class is alive, GMP's allocations in the calling
+ * thread are served from a thread-local bump allocator: freeing is a no-op
+ * and reallocating the last block extends it in place. The arena is reset
+ * when the object is destroyed, so no number allocated within the scope may
+ * be used after it. Numbers must not be shared with other threads, and
+ * scopes must not be nested.
+ */
+class arena_scope {
+public:
+
+	arena_scope() noexcept;
+	~arena_scope() noexcept;
+
+	arena_scope(const arena_scope&) = delete;
+	arena_scope& operator=(const arena_scope&) = delete;
+};
+
+} // namespace gmp_memory
+} // namespace profiling
@@ -26,8 +26,13 @@
  ***********************************************************************/
 
 // C++ includes
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <random>
+#include <string>
+#include <utility>
+#include <vector>
 
 // lal includes
 #include <lal/generate/tree_generator_type.hpp>
@@ -37,9 +42,17 @@
 #include <lal/graphs/rooted_tree.hpp>
 #include <lal/detail/graphs/conversions.hpp>
 #include <lal/iterators/E_iterator.hpp>
+#include <lal/iterators/Q_iterator.hpp>
 
 // common includes
+#include "batched_graph.hpp"
+#include "csr_graph.hpp"
+#include "edge_pair_tiles.hpp"
+#include "generate_complete_graphs.hpp"
 #include "graphs_pp.hpp"
+#include "mapped_file.hpp"
+#include "parallel_construction.hpp"
+#include "perf_counters.hpp"
 #include "time.hpp"
 
 namespace profiling {
@@ -142,12 +155,962 @@ void do_operation(const graphs_pp& parser, graph_t& g) noexcept
 	}
 }
 
+// Removes and adds back batches of random edges with the bulk methods of the
+// graph, for every combination of the flags of finish_bulk_add/remove, and
+// with the batched engine. Reports ns per edge operated.
+template <class graph_t>
+void do_bulk_matrix(const graphs_pp& parser, graph_t& g) noexcept
+{
+	const uint64_t R = parser.get_replicas();
+
+	lal::edge_list all_edges;
+	all_edges.reserve(g.get_num_edges());
+	for (lal::iterators::E_iterator it(g); not it.end(); it.next()) {
+		all_edges.push_back(it.get_edge());
+	}
+	std::mt19937 gen(1234);
+	std::shuffle(all_edges.begin(), all_edges.end(), gen);
+
+	const auto per_edge = [&](const double total, const std::size_t b)
+	{
+		// every replica removes and adds every edge of the batch
+		return total * 1'000'000.0 / static_cast<double>(2 * R * b);
+	};
+
+	// the bulk methods of the graph
+	const auto lal_bulk =
+		[&](const lal::edge_list& batch, const bool norm, const bool check)
+	{
+		const auto begin = profiling::now();
+		for (uint64_t r = 0; r < R; ++r) {
+			for (const auto& [u, v] : batch) {
+				g.remove_edge_bulk(u, v);
+			}
+			g.finish_bulk_remove(norm, check);
+			for (const auto& [u, v] : batch) {
+				g.add_edge_bulk(u, v);
+			}
+			g.finish_bulk_add(norm, check);
+		}
+		const auto end = profiling::now();
+		return per_edge(profiling::elapsed_time(begin, end), batch.size());
+	};
+
+	// the batched engine; 'query' is the time of the first has_edge query
+	// of every edge of the batch, which sorts the lists left dirty
+	const auto batched =
+		[&](const lal::edge_list& batch, const bool normalize, double& query)
+	{
+		batched_graph B(g);
+
+		const auto begin = profiling::now();
+		for (uint64_t r = 0; r < R; ++r) {
+			B.remove_edges(batch);
+			B.add_edges(batch, normalize);
+		}
+		const auto end = profiling::now();
+
+		uint64_t found = 0;
+		const auto begin_query = profiling::now();
+		for (const auto& [u, v] : batch) {
+			found += B.has_edge(u, v);
+		}
+		const auto end_query = profiling::now();
+		query = profiling::elapsed_time(begin_query, end_query) * 1'000'000.0 /
+				static_cast<double>(batch.size());
+
+		if (found != batch.size() or
+			B.get_num_edges() != g.get_num_edges()) {
+			std::cerr << "ERROR! The batched engine lost edges.\n";
+			std::abort();
+		}
+		return per_edge(profiling::elapsed_time(begin, end), batch.size());
+	};
+
+	std::cout << "Edges: " << all_edges.size() << '\n';
+	std::cout << "ns/edge of the bulk methods with flags (normalize,check)\n";
+	std::cout << "and of the batched engine, normalising at every update and\n";
+	std::cout << "deferring it. 'query' is ns/edge of the first queries\n";
+	std::cout << "after the updates of the engine.\n";
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(8) << "batch" << std::setw(10) << "(0,0)"
+			  << std::setw(10) << "(0,1)" << std::setw(10) << "(1,0)"
+			  << std::setw(10) << "(1,1)" << std::setw(12) << "batched"
+			  << std::setw(10) << "query" << std::setw(12) << "deferred"
+			  << std::setw(10) << "query" << '\n';
+	std::cout << "------------------------\n";
+
+	lal::edge_list batch;
+	for (const uint64_t b : parser.get_batch_sizes()) {
+		if (b > all_edges.size()) {
+			continue;
+		}
+		batch.assign(
+			all_edges.begin(),
+			all_edges.begin() + static_cast<std::ptrdiff_t>(b)
+		);
+
+		std::cout << std::setw(8) << b;
+		for (const bool norm : {false, true}) {
+			for (const bool check : {false, true}) {
+				std::cout << std::setw(10) << lal_bulk(batch, norm, check);
+			}
+		}
+		double query_normalized;
+		double query_deferred;
+		const double normalized = batched(batch, true, query_normalized);
+		const double deferred = batched(batch, false, query_deferred);
+		std::cout << std::setw(12) << normalized << std::setw(10)
+				  << query_normalized << std::setw(12) << deferred
+				  << std::setw(10) << query_deferred << '\n';
+	}
+}
+
+// Vertices and pairs of vertices queried by the read operations.
+struct query_set {
+	std::vector<lal::node> vertices;
+	lal::edge_list pairs;
+};
+
+// Makes q queries with access pattern 'access'.
+template <class graph_t>
+void make_queries(
+	const graph_t& g, const std::string& access, const uint64_t q, query_set& Q
+) noexcept
+{
+	const uint64_t n = g.get_num_nodes();
+	const lal::edge_list edges = g.get_edges();
+
+	std::mt19937_64 gen(1234);
+	std::uniform_int_distribution<lal::node> V(0, n - 1);
+	std::uniform_int_distribution<std::size_t> E(
+		0, edges.empty() ? 0 : edges.size() - 1
+	);
+
+	Q.vertices.resize(q);
+	Q.pairs.resize(q);
+	for (uint64_t i = 0; i < q; ++i) {
+		if (edges.empty()) {
+			Q.vertices[i] = V(gen);
+			Q.pairs[i] = {V(gen), V(gen)};
+		}
+		else if (access == "sequential") {
+			Q.vertices[i] = i % n;
+			Q.pairs[i] = edges[i % edges.size()];
+		}
+		else if (access == "random") {
+			Q.vertices[i] = V(gen);
+			if (i % 2 == 0) {
+				Q.pairs[i] = edges[E(gen)];
+			}
+			else {
+				Q.pairs[i] = {V(gen), V(gen)};
+			}
+		}
+		else {
+			// the endpoint of a random edge: vertices are chosen with
+			// probability proportional to their degree
+			const lal::edge& e = edges[E(gen)];
+			const lal::node u = (gen() % 2 == 0 ? e.first : e.second);
+			Q.vertices[i] = u;
+
+			// a vertex not adjacent to u, if one is found soon
+			lal::node v = V(gen);
+			for (uint64_t a = 0;
+				 a < 16 and (v == u or g.has_edge(u, v) or g.has_edge(v, u));
+				 ++a) {
+				v = V(gen);
+			}
+			Q.pairs[i] = {u, v};
+		}
+	}
+}
+
+// Result of running a set of queries.
+struct query_result {
+	// number of queries run
+	uint64_t num_queries = 0;
+	// value that depends on the answers to all the queries
+	uint64_t checksum = 0;
+};
+
+template <class graph_t>
+[[nodiscard]] query_result run_queries(
+	const std::string& operation,
+	const graph_t& g,
+	const query_set& Q,
+	const uint64_t q
+) noexcept
+{
+	query_result res;
+
+	if (operation == "neighbors") {
+		for (const lal::node u : Q.vertices) {
+			if constexpr (is_directed_graph<graph_t> or
+						  is_rooted_tree<graph_t>) {
+				for (const lal::node w : g.get_out_neighbors(u)) {
+					res.checksum += w;
+				}
+				for (const lal::node w : g.get_in_neighbors(u)) {
+					res.checksum += w;
+				}
+			}
+			else {
+				for (const lal::node w : g.get_neighbors(u)) {
+					res.checksum += w;
+				}
+			}
+		}
+		res.num_queries = Q.vertices.size();
+	}
+	else if (operation == "degree") {
+		for (const lal::node u : Q.vertices) {
+			res.checksum += g.get_degree(u);
+		}
+		res.num_queries = Q.vertices.size();
+	}
+	else if (operation == "has-edge") {
+		for (const auto& [u, v] : Q.pairs) {
+			res.checksum += g.has_edge(u, v);
+		}
+		res.num_queries = Q.pairs.size();
+	}
+	else if (operation == "E-iterator") {
+		for (lal::iterators::E_iterator it(g); not it.end(); it.next()) {
+			const auto [u, v] = it.get_edge();
+			res.checksum += u ^ v;
+			++res.num_queries;
+		}
+	}
+	else if (operation == "Q-iterator") {
+		for (lal::iterators::Q_iterator it(g);
+			 not it.end() and res.num_queries < q;
+			 it.next()) {
+			const auto [e1, e2] = it.get_edge_pair();
+			res.checksum += e1.first ^ e2.second;
+			++res.num_queries;
+		}
+	}
+	return res;
+}
+
+// Runs the read operation R times for every access pattern. Iterators do
+// not depend on the access pattern and are run once.
+template <class graph_t>
+void do_read_operation(
+	const graphs_pp& parser,
+	const graph_t& g,
+	const std::string& operation,
+	const std::vector<query_set>& sets,
+	perf::cache_counters& counters
+) noexcept
+{
+	const uint64_t R = parser.get_replicas();
+	const bool is_iterator =
+		operation == "E-iterator" or operation == "Q-iterator";
+
+	std::cout << "------------------------\n";
+	std::cout << "Operation: " << operation << '\n';
+	std::cout << std::setw(14) << "access" << std::setw(12) << "queries"
+			  << std::setw(12) << "ns/query" << std::setw(14) << "misses/query"
+			  << std::setw(12) << "miss rate" << std::setw(22) << "checksum"
+			  << '\n';
+
+	for (std::size_t a = 0; a < sets.size(); ++a) {
+		query_result res;
+		counters.start();
+		const auto begin = profiling::now();
+		for (uint64_t r = 0; r < R; ++r) {
+			const query_result rr = run_queries(
+				operation, g, sets[a], parser.get_num_queries()
+			);
+			res.num_queries += rr.num_queries;
+			res.checksum += rr.checksum;
+		}
+		const auto end = profiling::now();
+		counters.stop();
+
+		const double queries = static_cast<double>(res.num_queries);
+		const double total = profiling::elapsed_time(begin, end);
+
+		std::cout << std::setw(14)
+				  << (is_iterator ? "storage" : parser.get_access()[a])
+				  << std::setw(12) << res.num_queries / R << std::setw(12)
+				  << total * 1'000'000.0 / queries;
+		if (counters.available()) {
+			const double misses = static_cast<double>(counters.get_misses());
+			const double references =
+				static_cast<double>(counters.get_references());
+			std::cout << std::setw(14) << misses / queries << std::setw(12)
+					  << (references == 0 ? 0.0 : misses / references);
+		}
+		else {
+			std::cout << std::setw(14) << '-' << std::setw(12) << '-';
+		}
+		std::cout << std::setw(22) << res.checksum << '\n';
+
+		if (is_iterator) {
+			break;
+		}
+	}
+}
+
+template <class graph_t>
+void do_read_operations(const graphs_pp& parser, const graph_t& g) noexcept
+{
+	if (g.get_num_nodes() == 0) {
+		std::cerr << "Error: read operations need a non-empty graph.\n";
+		return;
+	}
+
+	std::cout << "Making queries...\n";
+	std::vector<query_set> sets(parser.get_access().size());
+	for (std::size_t a = 0; a < sets.size(); ++a) {
+		make_queries(
+			g, parser.get_access()[a], parser.get_num_queries(), sets[a]
+		);
+	}
+
+	perf::cache_counters counters;
+	if (not counters.available()) {
+		std::cout << "Hardware cache counters are not available.\n";
+	}
+
+	std::cout << std::fixed << std::setprecision(2);
+	const std::string& operation = parser.get_operation();
+	if (operation == "queries") {
+		const std::vector<std::string> all = {
+			"neighbors", "has-edge", "degree", "E-iterator", "Q-iterator"
+		};
+		for (const std::string& op : all) {
+			do_read_operation(parser, g, op, sets, counters);
+		}
+	}
+	else {
+		do_read_operation(parser, g, operation, sets, counters);
+	}
+}
+
+// Calls f(w) for every neighbour w of u, ignoring the orientation of the
+// edges. 'graph_t' is one of LAL's graphs or a CSR snapshot.
+template <class graph_t, typename Callable>
+void for_each_neighbor(const graph_t& g, const lal::node u, Callable&& f)
+{
+	if constexpr (requires { g.get_out_neighbors(u); }) {
+		for (const lal::node w : g.get_out_neighbors(u)) {
+			f(w);
+		}
+		for (const lal::node w : g.get_in_neighbors(u)) {
+			f(w);
+		}
+	}
+	else {
+		for (const lal::node w : g.get_neighbors(u)) {
+			f(w);
+		}
+	}
+}
+
+// Buffers of the read-only phases.
+struct read_buffers {
+	std::vector<lal::node> queue;
+	std::vector<uint64_t> dist;
+	std::vector<lal::node> parent;
+	std::vector<uint64_t> size;
+};
+
+// Reads every neighbour list once.
+template <class graph_t>
+[[nodiscard]] uint64_t scan_phase(const graph_t& g, read_buffers&) noexcept
+{
+	uint64_t sum = 0;
+	for (lal::node u = 0; u < g.get_num_nodes(); ++u) {
+		for_each_neighbor(
+			g,
+			u,
+			[&](const lal::node w)
+			{
+				sum += w;
+			}
+		);
+	}
+	return sum;
+}
+
+// Sum of the lengths of the edges in the identity arrangement, like the
+// evaluation of D in Dmin and DMax.
+template <class graph_t>
+[[nodiscard]] uint64_t
+sum_edge_lengths_phase(const graph_t& g, read_buffers&) noexcept
+{
+	uint64_t D = 0;
+	for (lal::node u = 0; u < g.get_num_nodes(); ++u) {
+		for_each_neighbor(
+			g,
+			u,
+			[&](const lal::node w)
+			{
+				D += (u < w ? w - u : u - w);
+			}
+		);
+	}
+	return D / 2;
+}
+
+// Breadth-first search from vertex 0. Leaves the visited vertices, in order,
+// in B.queue. Returns the sum of the distances to vertex 0.
+template <class graph_t>
+[[nodiscard]] uint64_t bfs_phase(const graph_t& g, read_buffers& B) noexcept
+{
+	const uint64_t n = g.get_num_nodes();
+	B.queue.resize(n);
+	B.dist.assign(n, n);
+	B.parent.assign(n, n);
+
+	std::size_t head = 0;
+	std::size_t tail = 0;
+	B.queue[tail++] = 0;
+	B.dist[0] = 0;
+	uint64_t sum = 0;
+	while (head < tail) {
+		const lal::node u = B.queue[head++];
+		sum += B.dist[u];
+		for_each_neighbor(
+			g,
+			u,
+			[&](const lal::node w)
+			{
+				if (B.dist[w] == n) {
+					B.dist[w] = B.dist[u] + 1;
+					B.parent[w] = u;
+					B.queue[tail++] = w;
+				}
+			}
+		);
+	}
+	B.queue.resize(tail);
+	return sum;
+}
+
+// Centroidal vertex of a tree, found with the sizes of the subtrees of a
+// breadth-first search from vertex 0, like in the centroid algorithms.
+// Returns the smallest centroidal vertex.
+template <class graph_t>
+[[nodiscard]] uint64_t
+centroid_phase(const graph_t& g, read_buffers& B) noexcept
+{
+	const uint64_t n = g.get_num_nodes();
+	(void)bfs_phase(g, B);
+
+	B.size.assign(n, 1);
+	for (std::size_t i = B.queue.size(); i-- > 1;) {
+		B.size[B.parent[B.queue[i]]] += B.size[B.queue[i]];
+	}
+
+	lal::node c = n;
+	for (lal::node u = 0; u < n and c == n; ++u) {
+		uint64_t largest = n - B.size[u];
+		for_each_neighbor(
+			g,
+			u,
+			[&](const lal::node w)
+			{
+				if (B.parent[w] == u) {
+					largest = std::max(largest, B.size[w]);
+				}
+			}
+		);
+		if (2 * largest <= n) {
+			c = u;
+		}
+	}
+	return c;
+}
+
+// Compares the read-only phases on the graph and on its CSR snapshot.
+template <class graph_t>
+void do_csr_operation(const graphs_pp& parser, const graph_t& g) noexcept
+{
+	const uint64_t R = parser.get_replicas();
+
+	if (g.get_num_nodes() == 0) {
+		std::cerr << "Error: operation 'csr' needs a non-empty graph.\n";
+		return;
+	}
+
+	const auto begin_freeze = profiling::now();
+	const auto csr = freeze(g);
+	const auto end_freeze = profiling::now();
+	std::cout << "Freeze time: "
+			  << profiling::time_to_str(
+					 profiling::elapsed_time(begin_freeze, end_freeze)
+				 )
+			  << '\n';
+
+	read_buffers B;
+	const auto measure = [&](const auto& G, const auto& phase, uint64_t& res)
+	{
+		const auto begin = profiling::now();
+		for (uint64_t r = 0; r < R; ++r) {
+			res = phase(G, B);
+		}
+		const auto end = profiling::now();
+		return profiling::elapsed_time(begin, end) * 1'000'000.0 /
+			   static_cast<double>(R);
+	};
+
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(18) << "phase" << std::setw(16) << "mutable (ns)"
+			  << std::setw(16) << "csr (ns)" << std::setw(10) << "speedup"
+			  << '\n';
+
+	const auto compare = [&](const std::string& name, const auto& phase)
+	{
+		uint64_t res_mutable = 0;
+		uint64_t res_csr = 0;
+		const double t_mutable = measure(g, phase, res_mutable);
+		const double t_csr = measure(csr, phase, res_csr);
+		if (res_mutable != res_csr) {
+			std::cerr << "ERROR! Phase '" << name
+					  << "' differs on the CSR snapshot.\n";
+			std::abort();
+		}
+		std::cout << std::setw(18) << name << std::setw(16) << t_mutable
+				  << std::setw(16) << t_csr << std::setw(10)
+				  << t_mutable / t_csr << '\n';
+	};
+
+	compare(
+		"scan",
+		[](const auto& G, read_buffers& BB)
+		{
+			return scan_phase(G, BB);
+		}
+	);
+	compare(
+		"sum edge lengths",
+		[](const auto& G, read_buffers& BB)
+		{
+			return sum_edge_lengths_phase(G, BB);
+		}
+	);
+	compare(
+		"bfs",
+		[](const auto& G, read_buffers& BB)
+		{
+			return bfs_phase(G, BB);
+		}
+	);
+	if constexpr (is_tree<graph_t>) {
+		compare(
+			"centroid",
+			[](const auto& G, read_buffers& BB)
+			{
+				return centroid_phase(G, BB);
+			}
+		);
+	}
+}
+
+// Builds the graph from its edge list with the sequential builder of LAL and
+// with the parallel builder, for 1, 2, 4, ..., P threads. Speedups are
+// relative to the parallel builder run with one thread, so that they compare
+// the same code; LAL's builder is shown for reference.
+template <class graph_t>
+void do_construct(const graphs_pp& parser, const graph_t& g) noexcept
+{
+	static constexpr bool directed =
+		is_directed_graph<graph_t> or is_rooted_tree<graph_t>;
+
+	const uint64_t R = parser.get_replicas();
+	const uint64_t max_threads = parser.get_threads();
+	const uint64_t n = g.get_num_nodes();
+	const lal::edge_list edges = g.get_edges();
+
+	graph_t sequential;
+	const auto begin = profiling::now();
+	for (uint64_t r = 0; r < R; ++r) {
+		sequential = lal::detail::from_edge_list_to_graph<graph_t>(
+			edges, false, false
+		);
+	}
+	const auto end = profiling::now();
+
+	// (threads, time) of every row, printed once the baseline is known
+	std::vector<std::pair<std::string, double>> rows;
+	rows.emplace_back(
+		"LAL", profiling::elapsed_time(begin, end) / static_cast<double>(R)
+	);
+
+	std::vector<lal::neighbourhood> out;
+	std::vector<lal::neighbourhood> in;
+	for (uint64_t t = 1;; t = std::min(2 * t, max_threads)) {
+		const auto begin_t = profiling::now();
+		for (uint64_t r = 0; r < R; ++r) {
+			build_adjacency_lists(
+				n, edges, directed, static_cast<int>(t), out, in
+			);
+		}
+		const auto end_t = profiling::now();
+
+		for (lal::node u = 0; u < n; ++u) {
+			bool equal;
+			if constexpr (directed) {
+				equal = out[u] == sequential.get_out_neighbors(u) and
+						in[u] == sequential.get_in_neighbors(u);
+			}
+			else {
+				equal = out[u] == sequential.get_neighbors(u);
+			}
+			if (not equal) {
+				std::cerr << "ERROR! The lists of vertex " << u
+						  << " built with " << t
+						  << " threads differ from LAL's.\n";
+				std::abort();
+			}
+		}
+
+		rows.emplace_back(
+			std::to_string(t),
+			profiling::elapsed_time(begin_t, end_t) / static_cast<double>(R)
+		);
+
+		if (t == max_threads) {
+			break;
+		}
+	}
+
+	// the parallel builder with one thread
+	const double base = rows[1].second;
+
+	std::cout << "Vertices: " << n << '\n';
+	std::cout << "Edges: " << edges.size() << '\n';
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(12) << "threads" << std::setw(16) << "time"
+			  << std::setw(12) << "Medges/s" << std::setw(10) << "speedup"
+			  << '\n';
+	for (const auto& [threads, ms] : rows) {
+		std::cout << std::setw(12) << threads << std::setw(16)
+				  << profiling::time_to_str(ms) << std::setw(12)
+				  << static_cast<double>(edges.size()) / (ms * 1000.0)
+				  << std::setw(10) << base / ms << '\n';
+	}
+}
+
+// Enumerates pairs of independent edges with the Q_iterator and with the
+// tiled enumeration, sequentially and with 1, 2, 4, ..., P threads.
+template <class graph_t>
+void do_Q_tiles(const graphs_pp& parser, const graph_t& g) noexcept
+{
+	const uint64_t R = parser.get_replicas();
+	const uint64_t q = parser.get_num_queries();
+	const uint64_t max_threads =
+		parser.has_threads() ? parser.get_threads() : 1;
+	const uint64_t Q_size = size_of_Q(g);
+
+	const edge_pair_tiles tiles(g.get_edges(), parser.get_tile_size());
+
+	// the first tiles, which contain at least q pairs of edges
+	std::size_t num_tiles = 0;
+	for (uint64_t capacity = 0;
+		 num_tiles < tiles.num_tiles() and capacity < q;
+		 ++num_tiles) {
+		capacity += tiles.tile_capacity(num_tiles);
+	}
+
+	// pairs of independent edges in those tiles, counted without
+	// enumerating them
+	uint64_t expected = 0;
+	for (std::size_t t = 0; t < num_tiles; ++t) {
+		expected += tiles.tile_size_of_Q(t);
+	}
+	if (num_tiles == tiles.num_tiles() and expected != Q_size) {
+		std::cerr << "ERROR! The tiles contain " << expected
+				  << " pairs instead of " << Q_size << ".\n";
+		std::abort();
+	}
+
+	std::cout << "Edges: " << g.get_num_edges() << '\n';
+	std::cout << "Size of Q: " << Q_size << '\n';
+	std::cout << "Tiles: " << num_tiles << " of " << tiles.num_tiles() << '\n';
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(12) << "method" << std::setw(16) << "pairs"
+			  << std::setw(16) << "time" << std::setw(12) << "Mpairs/s"
+			  << std::setw(10) << "speedup" << '\n';
+	std::cout << "------------------------\n";
+
+	const auto rate = [](const uint64_t pairs, const double ms)
+	{
+		return static_cast<double>(pairs) / (ms * 1000.0);
+	};
+	const auto print_row = [&](const std::string& method,
+							   const uint64_t pairs,
+							   const double ms,
+							   const double base)
+	{
+		std::cout << std::setw(12) << method << std::setw(16) << pairs
+				  << std::setw(16) << profiling::time_to_str(ms)
+				  << std::setw(12) << rate(pairs, ms) << std::setw(10)
+				  << rate(pairs, ms) / base << '\n';
+	};
+	const auto check = [&](const std::string& method, const uint64_t pairs)
+	{
+		if (pairs != expected) {
+			std::cerr << "ERROR! Method '" << method << "' enumerated "
+					  << pairs << " pairs instead of " << expected << ".\n";
+			std::abort();
+		}
+	};
+
+	// Q_iterator
+	uint64_t pairs = 0;
+	uint64_t checksum = 0;
+	auto begin = profiling::now();
+	for (uint64_t r = 0; r < R; ++r) {
+		pairs = 0;
+		for (lal::iterators::Q_iterator it(g); not it.end() and pairs < q;
+			 it.next()) {
+			const auto [e1, e2] = it.get_edge_pair();
+			checksum += e1.first ^ e2.second;
+			++pairs;
+		}
+	}
+	auto end = profiling::now();
+	if (pairs != std::min(q, Q_size)) {
+		std::cerr << "ERROR! The Q_iterator enumerated " << pairs
+				  << " pairs instead of " << std::min(q, Q_size) << ".\n";
+		std::abort();
+	}
+	double ms = profiling::elapsed_time(begin, end) / static_cast<double>(R);
+	const double base = rate(pairs, ms);
+	print_row("Q_iterator", pairs, ms, base);
+
+	// tiled, sequential
+	begin = profiling::now();
+	for (uint64_t r = 0; r < R; ++r) {
+		pairs = 0;
+		for (std::size_t t = 0; t < num_tiles; ++t) {
+			tiles.for_each_in_tile(
+				t,
+				[&](const lal::edge& e1, const lal::edge& e2)
+				{
+					checksum += e1.first ^ e2.second;
+					++pairs;
+				}
+			);
+		}
+	}
+	end = profiling::now();
+	check("tiled", pairs);
+	ms = profiling::elapsed_time(begin, end) / static_cast<double>(R);
+	print_row("tiled", pairs, ms, base);
+
+	// tiled, in parallel
+	for (uint64_t P = 1;; P = std::min(2 * P, max_threads)) {
+		begin = profiling::now();
+		for (uint64_t r = 0; r < R; ++r) {
+			uint64_t p = 0;
+			uint64_t c = 0;
+#pragma omp parallel for num_threads(static_cast<int>(P)) \
+	schedule(dynamic, 1) reduction(+ : p, c)
+			for (std::size_t t = 0; t < num_tiles; ++t) {
+				tiles.for_each_in_tile(
+					t,
+					[&](const lal::edge& e1, const lal::edge& e2)
+					{
+						c += e1.first ^ e2.second;
+						++p;
+					}
+				);
+			}
+			pairs = p;
+			checksum += c;
+		}
+		end = profiling::now();
+		check("tiled " + std::to_string(P), pairs);
+		ms = profiling::elapsed_time(begin, end) / static_cast<double>(R);
+		print_row("tiled " + std::to_string(P), pairs, ms, base);
+
+		if (P == max_threads) {
+			break;
+		}
+	}
+
+	// the checksum only keeps the enumerations from being optimised away
+	if (checksum == 0) {
+		std::cout << "Checksum: " << checksum << '\n';
+	}
+}
+
+void output_file_info(
+	const std::string& path,
+	const std::size_t bytes,
+	const uint64_t n,
+	const uint64_t m,
+	const double parse_time,
+	const double build_time
+) noexcept
+{
+	const double MB = static_cast<double>(bytes) / 1'000'000.0;
+	const double edges = static_cast<double>(m);
+
+	std::cout << "File: " << path << '\n';
+	std::cout << "    Size: " << MB << " MB\n";
+	std::cout << "    Vertices: " << n << '\n';
+	std::cout << "    Edges: " << m << '\n';
+	std::cout << "Parsing time: " << profiling::time_to_str(parse_time)
+			  << '\n';
+	std::cout << "    MB/s: " << MB / (parse_time / 1000.0) << '\n';
+	std::cout << "    Edges/s: " << edges / (parse_time / 1000.0) << '\n';
+	std::cout << "Construction time (parsing and bulk add): "
+			  << profiling::time_to_str(build_time) << '\n';
+	std::cout << "    Without parsing: "
+			  << profiling::time_to_str(std::max(0.0, build_time - parse_time))
+			  << '\n';
+	std::cout << "    Edges/s: " << edges / (build_time / 1000.0) << '\n';
+}
+
+// Builds the graph in the edge list or head vector file given to the parser.
+// The file is memory-mapped and read twice. The first pass only parses it,
+// to find the number of vertices and check the contents, and the second one
+// adds every edge with the bulk methods, so no edge list is ever stored.
+// Returns false if the file cannot be read or is malformed.
+template <class graph_t>
+[[nodiscard]] bool
+from_file(const graphs_pp& parser, const bool is_edge_list, graph_t& g)
+{
+	const std::string& path = is_edge_list ? parser.get_edge_list_file()
+										   : parser.get_head_vector_file();
+
+	io::mapped_file file;
+	if (not file.open(path)) {
+		return false;
+	}
+
+	std::cout << "Parsing file...\n";
+	uint64_t count = 0;
+	uint64_t max = 0;
+	const auto begin_parse = profiling::now();
+	const bool correct = io::for_each_integer(
+		file.begin(),
+		file.end(),
+		[&](const uint64_t x)
+		{
+			++count;
+			max = std::max(max, x);
+		}
+	);
+	const auto end_parse = profiling::now();
+
+	if (not correct) {
+		std::cerr << "Error: file '" << path
+				  << "' does not only contain unsigned integers.\n";
+		return false;
+	}
+
+	uint64_t n;
+	if (is_edge_list) {
+		if (count % 2 == 1) {
+			std::cerr << "Error: file '" << path
+					  << "' contains an odd number of vertices.\n";
+			return false;
+		}
+		n = parser.has_n() ? parser.get_n() : (count == 0 ? 0 : max + 1);
+		if (count > 0 and max >= n) {
+			std::cerr << "Error: vertex " << max << " is out of range.\n";
+			return false;
+		}
+	}
+	else {
+		n = count;
+		if (max > n) {
+			std::cerr << "Error: parent " << max << " is out of range.\n";
+			return false;
+		}
+	}
+
+	std::cout << "Building graph...\n";
+	const auto begin_build = profiling::now();
+	g.init(n);
+	lal::node root = n;
+	if (is_edge_list) {
+		bool first = true;
+		lal::node u = 0;
+		(void)io::for_each_integer(
+			file.begin(),
+			file.end(),
+			[&](const uint64_t x)
+			{
+				if (first) {
+					u = x;
+				}
+				else {
+					g.add_edge_bulk(u, x);
+				}
+				first = not first;
+			}
+		);
+	}
+	else {
+		lal::node v = 0;
+		(void)io::for_each_integer(
+			file.begin(),
+			file.end(),
+			[&](const uint64_t x)
+			{
+				if (x == 0) {
+					root = v;
+				}
+				else {
+					g.add_edge_bulk(x - 1, v);
+				}
+				++v;
+			}
+		);
+	}
+	g.finish_bulk_add(false, false);
+	if constexpr (is_rooted_tree<graph_t>) {
+		// the root of an edge list is the vertex without parent
+		for (lal::node u = 0; is_edge_list and u < n; ++u) {
+			if (g.get_in_degree(u) == 0) {
+				root = u;
+				break;
+			}
+		}
+		if (root < n) {
+			g.set_root(root);
+		}
+	}
+	const auto end_build = profiling::now();
+
+	output_file_info(
+		path,
+		file.size(),
+		n,
+		g.get_num_edges(),
+		profiling::elapsed_time(begin_parse, end_parse),
+		profiling::elapsed_time(begin_build, end_build)
+	);
+	return true;
+}
+
 template <class graph_t>
 void do_profiling(const graphs_pp& parser) noexcept
 {
 	const std::string& where = parser.get_graph_from();
 	graph_t g;
-	if (where == "edge-list") {
+	if (where == "edge-list" and parser.has_edge_list_file()) {
+		if (not from_file(parser, true, g)) {
+			return;
+		}
+	}
+	else if (where == "head-vector" and parser.has_head_vector_file()) {
+		if (not from_file(parser, false, g)) {
+			return;
+		}
+	}
+	else if (where == "edge-list") {
 		g = lal::detail::from_edge_list_to_graph<graph_t>(
 			parser.get_edge_list(), false, false
 		);
@@ -170,8 +1133,41 @@ void do_profiling(const graphs_pp& parser) noexcept
 			g = gen.get_tree();
 		}
 	}
+	else if (where == "complete") {
+		if constexpr (is_undirected_graph<graph_t>) {
+			g = generate::complete_graph(parser.get_n());
+		}
+	}
+	else if (where == "complete-bipartite") {
+		if constexpr (is_undirected_graph<graph_t>) {
+			g = generate::complete_bipartite_graph(
+				parser.get_n(), parser.get_n2()
+			);
+		}
+	}
 
-	do_operation(parser, g);
+	const std::string& operation = parser.get_operation();
+	if (operation == "add/remove-edges" or
+		operation == "add/remove-edges-bulk") {
+		do_operation(parser, g);
+	}
+	else if (operation == "csr") {
+		do_csr_operation(parser, g);
+	}
+	else if (operation == "bulk-matrix") {
+		do_bulk_matrix(parser, g);
+	}
+	else if (operation == "construct") {
+		do_construct(parser, g);
+	}
+	else if (operation == "Q-tiles") {
+		if constexpr (is_undirected_graph<graph_t> or is_free_tree<graph_t>) {
+			do_Q_tiles(parser, g);
+		}
+	}
+	else {
+		do_read_operations(parser, g);
+	}
 }
 
 } // namespace graphs
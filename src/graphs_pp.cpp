@@ -30,6 +30,7 @@
 // C++ includes
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
 
 namespace profiling {
 namespace graphs {
@@ -47,8 +48,27 @@ void graphs_pp::print_usage() const noexcept
 	std::cout << "    -el k u_1 v_1 ... u_k v_k\n";
 	std::cout << "        Edge list of the graph.\n";
 	std::cout << '\n';
+	std::cout << "    -hv-file f\n";
+	std::cout << "        File with the head vector of the graph: the parents\n";
+	std::cout << "        p_1 ... p_n separated by whitespace.\n";
+	std::cout << '\n';
+	std::cout << "    -el-file f\n";
+	std::cout << "        File with the edge list of the graph: the vertices\n";
+	std::cout << "        u_1 v_1 ... u_k v_k separated by whitespace. The number\n";
+	std::cout << "        of vertices is the largest vertex plus one, or '-n'.\n";
+	std::cout << '\n';
+	std::cout << "        Files are memory-mapped and read twice: the first pass\n";
+	std::cout << "        only parses them, the second one also builds the graph\n";
+	std::cout << "        with the bulk-add methods.\n";
+	std::cout << '\n';
 	std::cout << "    -n n\n";
-	std::cout << "        Indicate the number of vertices of the trees.\n";
+	std::cout << "        Indicate the number of vertices of the trees, of the\n";
+	std::cout << "        complete graph, or of the first part of the complete\n";
+	std::cout << "        bipartite graph.\n";
+	std::cout << '\n';
+	std::cout << "    -n2 n\n";
+	std::cout << "        Number of vertices of the second part of the complete\n";
+	std::cout << "        bipartite graph.\n";
 	std::cout << '\n';
 	std::cout << "    -T T\n";
 	std::cout << "        Indicate the number of trees to generate.\n";
@@ -58,9 +78,12 @@ void graphs_pp::print_usage() const noexcept
 	std::cout << '\n';
 	std::cout << "    -graph-from\n";
 	std::cout << "        Where to get the graph from.\n";
-	std::cout << "            head-vector (requires '-hv')\n";
-	std::cout << "            edge-list (requires '-el')\n";
+	std::cout << "            head-vector (requires '-hv' or '-hv-file')\n";
+	std::cout << "            edge-list (requires '-el' or '-el-file')\n";
 	std::cout << "            random-tree (labelled trees only)\n";
+	std::cout << "            complete (requires '-n', undirected_graph only)\n";
+	std::cout << "            complete-bipartite (requires '-n' and '-n2',\n";
+	std::cout << "                undirected_graph only)\n";
 	std::cout << '\n';
 	std::cout << "    -operation o\n";
 	std::cout << "        Operation to perform. Possible values:\n";
@@ -68,6 +91,71 @@ void graphs_pp::print_usage() const noexcept
 	std::cout << "                a random set of edges.\n";
 	std::cout << "            - add/remove-edges-bulk : first remove and then adds\n";
 	std::cout << "                a series of edges in bulk.\n";
+	std::cout << "            - neighbors : scan the neighbours of vertices.\n";
+	std::cout << "            - has-edge : query pairs of vertices.\n";
+	std::cout << "            - degree : query the degree of vertices.\n";
+	std::cout << "            - E-iterator : iterate over all edges.\n";
+	std::cout << "            - Q-iterator : iterate over the first q pairs of\n";
+	std::cout << "                independent edges.\n";
+	std::cout << "            - queries : all of the above read operations.\n";
+	std::cout << "            - csr : compare read-only phases (neighbour scan,\n";
+	std::cout << "                sum of edge lengths, BFS and, for trees, the\n";
+	std::cout << "                centroid) on the graph and on its immutable\n";
+	std::cout << "                CSR snapshot. Each phase is run R times.\n";
+	std::cout << "            - bulk-matrix : remove and add back batches of\n";
+	std::cout << "                random edges with the bulk methods, for every\n";
+	std::cout << "                combination of the flags 'normalize' and\n";
+	std::cout << "                'check' of finish_bulk_add/remove, and with a\n";
+	std::cout << "                batched engine that sorts every batch once and\n";
+	std::cout << "                merges it into the adjacency lists. The engine\n";
+	std::cout << "                is run normalising the lists at every update,\n";
+	std::cout << "                and deferring it until the first query.\n";
+	std::cout << "                Reports ns/edge for every batch size.\n";
+	std::cout << "            - construct : build the graph from its edge list\n";
+	std::cout << "                with the sequential builder of LAL and with a\n";
+	std::cout << "                parallel builder using 1, 2, 4, ..., P threads\n";
+	std::cout << "                (requires '-threads'), and check that the\n";
+	std::cout << "                lists built are identical. Reports build time,\n";
+	std::cout << "                millions of edges per second, and the speedup\n";
+	std::cout << "                over the parallel builder with one thread.\n";
+	std::cout << "            - Q-tiles : enumerate the first q pairs of independent\n";
+	std::cout << "                edges (see '-queries') with the Q_iterator, and\n";
+	std::cout << "                at least as many with the tiled enumeration,\n";
+	std::cout << "                sequentially and with 1, 2, 4, ..., P threads\n";
+	std::cout << "                (see '-threads'). Reports millions of pairs per\n";
+	std::cout << "                second. Undirected graphs and free trees only.\n";
+	std::cout << "        Read operations report ns/query and, when the hardware\n";
+	std::cout << "        counters are available, cache misses per query and the\n";
+	std::cout << "        cache miss rate. Every query set is run R times.\n";
+	std::cout << '\n';
+	std::cout << "    -queries q\n";
+	std::cout << "        Number of queries of the read operations.\n";
+	std::cout << "        Default: 1000000\n";
+	std::cout << '\n';
+	std::cout << "    -access a_1,a_2,...,a_k\n";
+	std::cout << "        Access patterns of the read operations:\n";
+	std::cout << "            sequential : vertices in increasing order, and the\n";
+	std::cout << "                edges of the graph in the order they are stored.\n";
+	std::cout << "            random : uniformly random vertices, and random pairs\n";
+	std::cout << "                of vertices, half of them edges.\n";
+	std::cout << "            adversarial : endpoints of random edges, so that\n";
+	std::cout << "                vertices of high degree are queried more often,\n";
+	std::cout << "                and pairs made of one such vertex and a vertex\n";
+	std::cout << "                not adjacent to it, so that searches fail.\n";
+	std::cout << "        Default: sequential,random,adversarial\n";
+	std::cout << '\n';
+	std::cout << "    -threads P\n";
+	std::cout << "        Maximum number of threads of operations 'construct' and\n";
+	std::cout << "        'Q-tiles'. Default for 'Q-tiles': 1.\n";
+	std::cout << '\n';
+	std::cout << "    -tile-size b\n";
+	std::cout << "        Number of edges of the blocks of the tiles of 'Q-tiles'.\n";
+	std::cout << "        Default: 1024\n";
+	std::cout << '\n';
+	std::cout << "    -batch-sizes b_1,b_2,...,b_k\n";
+	std::cout << "        Number of edges of the batches of 'bulk-matrix'. Sizes\n";
+	std::cout << "        larger than the number of edges are skipped.\n";
+	std::cout << "        Default: 1,16,256,4096,65536\n";
 	std::cout << '\n';
 	std::cout << "    -graph-class g\n";
 	std::cout << "        Graph class to use. Possible values:\n";
@@ -98,6 +186,11 @@ int graphs_pp::parse_params() noexcept
 			m_has_n = true;
 			++i;
 		}
+		else if (param == "-n2") {
+			m_n2 = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_has_n2 = true;
+			++i;
+		}
 		else if (param == "-R") {
 			m_R = static_cast<uint64_t>(atoi(m_argv[i + 1]));
 			m_has_R = true;
@@ -128,6 +221,49 @@ int graphs_pp::parse_params() noexcept
 			m_has_list = true;
 			i = i + 1 + 2 * k;
 		}
+		else if (param == "-hv-file") {
+			m_hv_file = std::string(m_argv[i + 1]);
+			m_has_hv_file = true;
+			++i;
+		}
+		else if (param == "-el-file") {
+			m_list_file = std::string(m_argv[i + 1]);
+			m_has_list_file = true;
+			++i;
+		}
+		else if (param == "-queries") {
+			m_num_queries = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			++i;
+		}
+		else if (param == "-access") {
+			m_access.clear();
+			std::stringstream ss(m_argv[i + 1]);
+			std::string a;
+			while (std::getline(ss, a, ',')) {
+				m_access.push_back(a);
+			}
+			++i;
+		}
+		else if (param == "-threads") {
+			m_threads = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			m_has_threads = true;
+			++i;
+		}
+		else if (param == "-tile-size") {
+			m_tile_size = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			++i;
+		}
+		else if (param == "-batch-sizes") {
+			m_batch_sizes.clear();
+			std::stringstream ss(m_argv[i + 1]);
+			std::string b;
+			while (std::getline(ss, b, ',')) {
+				m_batch_sizes.push_back(
+					static_cast<uint64_t>(atoll(b.c_str()))
+				);
+			}
+			++i;
+		}
 		else if (param == "-operation") {
 			m_operation = std::string(m_argv[i + 1]);
 			++i;
@@ -178,20 +314,83 @@ int graphs_pp::check_errors() const noexcept
 		return 1;
 	}
 	if (m_graph_from != "head-vector" and m_graph_from != "edge-list" and
-		m_graph_from != "random-tree") {
+		m_graph_from != "random-tree" and m_graph_from != "complete" and
+		m_graph_from != "complete-bipartite") {
 		std::cerr << "Error: wrong value for parameter '-graph-from'.\n";
 		return 1;
 	}
+	if (m_graph_from == "complete" or m_graph_from == "complete-bipartite") {
+		if (m_graph_class != "undirected_graph") {
+			std::cerr << "Error: complete graphs are only available for\n";
+			std::cerr << "    graph class 'undirected_graph'.\n";
+			return 1;
+		}
+		if (not m_has_n) {
+			std::cerr << "Error: missing parameter '-n'.\n";
+			return 1;
+		}
+	}
+	if (m_graph_from == "complete-bipartite" and not m_has_n2) {
+		std::cerr << "Error: missing parameter '-n2'.\n";
+		return 1;
+	}
+	if (m_graph_from == "edge-list" and not m_has_list and
+		not m_has_list_file) {
+		std::cerr << "Error: missing parameter '-el' or '-el-file'.\n";
+		return 1;
+	}
+	if (m_graph_from == "head-vector" and not m_has_hv and not m_has_hv_file) {
+		std::cerr << "Error: missing parameter '-hv' or '-hv-file'.\n";
+		return 1;
+	}
 
 	if (m_operation == "none") {
 		std::cerr << "Error: missing parameter '-operation'.\n";
 		return 1;
 	}
 	if (m_operation != "add/remove-edges" and
-		m_operation != "add/remove-edges-bulk") {
+		m_operation != "add/remove-edges-bulk" and
+		m_operation != "neighbors" and m_operation != "has-edge" and
+		m_operation != "degree" and m_operation != "E-iterator" and
+		m_operation != "Q-iterator" and m_operation != "queries" and
+		m_operation != "csr" and m_operation != "bulk-matrix" and
+		m_operation != "construct" and m_operation != "Q-tiles") {
 		std::cerr << "Error: wrong value for parameter '-operation'.\n";
 		return 1;
 	}
+	if (m_operation == "construct" and not m_has_threads) {
+		std::cerr << "Error: missing parameter '-threads'.\n";
+		return 1;
+	}
+	if (m_has_threads and m_threads == 0) {
+		std::cerr << "Error: the number of threads must be positive.\n";
+		return 1;
+	}
+	if (m_operation == "Q-tiles") {
+		if (m_graph_class != "undirected_graph" and
+			m_graph_class != "free_tree") {
+			std::cerr << "Error: operation 'Q-tiles' is only available for\n";
+			std::cerr << "    undirected graphs and free trees.\n";
+			return 1;
+		}
+		if (m_tile_size == 0) {
+			std::cerr << "Error: the tile size must be positive.\n";
+			return 1;
+		}
+	}
+	for (const std::string& a : m_access) {
+		if (a != "sequential" and a != "random" and a != "adversarial") {
+			std::cerr << "Error: wrong access pattern '" << a << "'.\n";
+			return 1;
+		}
+	}
+
+	for (const uint64_t b : m_batch_sizes) {
+		if (b == 0) {
+			std::cerr << "Error: batch sizes must be positive.\n";
+			return 1;
+		}
+	}
 
 	return 0;
 }
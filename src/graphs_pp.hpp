@@ -30,6 +30,7 @@
 // C++ includes
 #include <cstdint>
 #include <string>
+#include <vector>
 
 // lal includes
 #include <lal/basic_types.hpp>
@@ -54,6 +55,26 @@ public:
 	{
 		return m_hv;
 	}
+	[[nodiscard]] bool has_edge_list_file() const noexcept
+	{
+		return m_has_list_file;
+	}
+	[[nodiscard]] const std::string& get_edge_list_file() const noexcept
+	{
+		return m_list_file;
+	}
+	[[nodiscard]] bool has_head_vector_file() const noexcept
+	{
+		return m_has_hv_file;
+	}
+	[[nodiscard]] const std::string& get_head_vector_file() const noexcept
+	{
+		return m_hv_file;
+	}
+	[[nodiscard]] bool has_n() const noexcept
+	{
+		return m_has_n;
+	}
 	[[nodiscard]] const std::string& get_graph_class() const noexcept
 	{
 		return m_graph_class;
@@ -70,10 +91,38 @@ public:
 	{
 		return m_n;
 	}
+	[[nodiscard]] uint64_t get_n2() const noexcept
+	{
+		return m_n2;
+	}
 	[[nodiscard]] uint64_t get_replicas() const noexcept
 	{
 		return m_R;
 	}
+	[[nodiscard]] uint64_t get_num_queries() const noexcept
+	{
+		return m_num_queries;
+	}
+	[[nodiscard]] const std::vector<std::string>& get_access() const noexcept
+	{
+		return m_access;
+	}
+	[[nodiscard]] bool has_threads() const noexcept
+	{
+		return m_has_threads;
+	}
+	[[nodiscard]] uint64_t get_threads() const noexcept
+	{
+		return m_threads;
+	}
+	[[nodiscard]] uint64_t get_tile_size() const noexcept
+	{
+		return m_tile_size;
+	}
+	[[nodiscard]] const std::vector<uint64_t>& get_batch_sizes() const noexcept
+	{
+		return m_batch_sizes;
+	}
 
 	void print_usage() const noexcept;
 
@@ -96,10 +145,30 @@ private:
 	uint64_t m_n = 0;
 	bool m_has_n = false;
 
+	// size of the second part of complete bipartite graphs
+	uint64_t m_n2 = 0;
+	bool m_has_n2 = false;
+
 	// number of replicas (times to repeat the same execution)
 	uint64_t m_R = 0;
 	bool m_has_R = false;
 
+	// number of queries of the read operations
+	uint64_t m_num_queries = 1000000;
+
+	// access patterns of the read operations
+	std::vector<std::string> m_access = {"sequential", "random", "adversarial"};
+
+	// maximum number of threads of the parallel operations
+	uint64_t m_threads = 0;
+	bool m_has_threads = false;
+
+	// number of edges of the blocks of the tiled enumeration of Q
+	uint64_t m_tile_size = 1024;
+
+	// sizes of the batches of the bulk update operations
+	std::vector<uint64_t> m_batch_sizes = {1, 16, 256, 4096, 65536};
+
 	// edge list of the graph
 	lal::edge_list m_list;
 	bool m_has_list = false;
@@ -108,6 +177,14 @@ private:
 	lal::head_vector m_hv;
 	bool m_has_hv = false;
 
+	// file with the edge list of the graph
+	std::string m_list_file;
+	bool m_has_list_file = false;
+
+	// file with the head vector of the graph
+	std::string m_hv_file;
+	bool m_has_hv_file = false;
+
 	uint64_t m_argc;
 	char **m_argv;
 };
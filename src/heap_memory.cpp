@@ -0,0 +1,147 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "heap_memory.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+// C includes
+#include <malloc.h>
+
+namespace profiling {
+namespace heap_memory {
+
+#if defined PROFILING_HEAP_MEMORY
+
+namespace {
+
+thread_local bool counting = false;
+thread_local counters thread_counters;
+// bytes in use, relative to the start of the counting
+thread_local int64_t thread_current = 0;
+
+void count_allocation(void *ptr) noexcept
+{
+	if (counting) {
+		const auto size = static_cast<int64_t>(malloc_usable_size(ptr));
+		++thread_counters.allocations;
+		thread_counters.bytes += static_cast<uint64_t>(size);
+		thread_current += size;
+		thread_counters.peak = std::max(thread_counters.peak, thread_current);
+	}
+}
+
+void count_free(void *ptr) noexcept
+{
+	if (counting) {
+		thread_current -= static_cast<int64_t>(malloc_usable_size(ptr));
+	}
+}
+
+[[nodiscard]] void *allocate(const std::size_t size)
+{
+	void * const ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	count_allocation(ptr);
+	return ptr;
+}
+
+void deallocate(void *ptr) noexcept
+{
+	if (ptr != nullptr) {
+		count_free(ptr);
+		std::free(ptr);
+	}
+}
+
+} // namespace
+
+void start_counting() noexcept
+{
+	thread_counters = counters{};
+	thread_current = 0;
+	counting = true;
+}
+
+counters stop_counting() noexcept
+{
+	counting = false;
+	return thread_counters;
+}
+
+#else
+
+void start_counting() noexcept { }
+
+counters stop_counting() noexcept
+{
+	return counters{};
+}
+
+#endif
+
+} // namespace heap_memory
+} // namespace profiling
+
+#if defined PROFILING_HEAP_MEMORY
+
+void *operator new(std::size_t size)
+{
+	return profiling::heap_memory::allocate(size);
+}
+
+void *operator new[](std::size_t size)
+{
+	return profiling::heap_memory::allocate(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+	profiling::heap_memory::deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+	profiling::heap_memory::deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+	profiling::heap_memory::deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+	profiling::heap_memory::deallocate(ptr);
+}
+
+#endif
@@ -0,0 +1,73 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+
+namespace profiling {
+namespace heap_memory {
+
+/*
+ * Accounting of the heap memory allocated with operator new.
+ *
+ * The replaceable operator new and operator delete are defined in
+ * heap_memory.cpp only when PROFILING_HEAP_MEMORY is defined (configure with
+ * -DENABLE_HEAP_MEMORY=ON), so that the allocations of the other profilers
+ * are not slowed down. They only count while the calling thread is between a
+ * call to start_counting() and a call to stop_counting(). Sizes are those
+ * reported by malloc_usable_size, so they include the allocator's rounding.
+ * Without PROFILING_HEAP_MEMORY, all counters are zero.
+ */
+
+#if defined PROFILING_HEAP_MEMORY
+static constexpr bool enabled = true;
+#else
+static constexpr bool enabled = false;
+#endif
+
+// Memory allocated by the calling thread while counting.
+struct counters {
+	// number of calls to operator new
+	uint64_t allocations = 0;
+	// total number of bytes allocated
+	uint64_t bytes = 0;
+	// largest number of bytes in use at the same time, relative to the
+	// memory in use when counting started
+	int64_t peak = 0;
+};
+
+// Starts counting the allocations of the calling thread.
+void start_counting() noexcept;
+
+// Stops counting the allocations of the calling thread and returns the
+// counters accumulated since the last call to start_counting().
+[[nodiscard]] counters stop_counting() noexcept;
+
+} // namespace heap_memory
+} // namespace profiling
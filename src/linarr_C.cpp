@@ -32,12 +32,12 @@
 
 // lal includes
 #include <lal/generate/rand_arrangements.hpp>
-#include <lal/generate/rand_ulab_free_trees.hpp>
 #include <lal/linarr/C/C.hpp>
 #include <lal/graphs/free_tree.hpp>
 
 // common includes
 #include "time.hpp"
+#include "generate_tree_shapes.hpp"
 #include "linarr_C_pp.hpp"
 
 namespace profiling {
@@ -66,14 +66,15 @@ uint64_t profile_algo(
 		A,
 	const uint64_t n,
 	const uint64_t T,
-	const uint64_t N
+	const uint64_t N,
+	const generate::tree_shape& shape
 ) noexcept
 {
 	double total = 0.0;
 
 	uint64_t asdf = 0;
 
-	lal::generate::rand_ulab_free_trees Gen(n, 1234);
+	generate::tree_shape_generator<lal::graphs::free_tree> Gen(n, shape, 1234);
 
 	for (uint64_t t = 0; t < T; ++t) {
 		const lal::graphs::free_tree tree = Gen.get_tree();
@@ -105,12 +106,13 @@ void profile_algo_list(
 		A,
 	const uint64_t n,
 	const uint64_t T,
-	const uint64_t N
+	const uint64_t N,
+	const generate::tree_shape& shape
 ) noexcept
 {
 	double total = 0.0;
 
-	lal::generate::rand_ulab_free_trees Gen(n, 1234);
+	generate::tree_shape_generator<lal::graphs::free_tree> Gen(n, shape, 1234);
 
 	for (uint64_t t = 0; t < T; ++t) {
 		const lal::graphs::free_tree tree = Gen.get_tree();
@@ -153,6 +155,7 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 	const uint64_t n = parser.get_n();
 	const uint64_t T = parser.get_T();
 	const uint64_t N = parser.get_N();
+	const generate::tree_shape& shape = parser.get_shape();
 
 	// bruteforce
 	if (what == "brute_force") {
@@ -166,7 +169,8 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 			},
 			n,
 			T,
-			N
+			N,
+			shape
 		);
 	}
 	else if (what == "brute_force_list") {
@@ -180,7 +184,8 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 			},
 			n,
 			T,
-			N
+			N,
+			shape
 		);
 	}
 	// dynamic programming
@@ -195,7 +200,8 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 			},
 			n,
 			T,
-			N
+			N,
+			shape
 		);
 	}
 	else if (what == "dynamic_programming_list") {
@@ -209,7 +215,8 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 			},
 			n,
 			T,
-			N
+			N,
+			shape
 		);
 	}
 	// ladder
@@ -222,7 +229,8 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 			},
 			n,
 			T,
-			N
+			N,
+			shape
 		);
 	}
 	else if (what == "ladder_list") {
@@ -236,7 +244,8 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 			},
 			n,
 			T,
-			N
+			N,
+			shape
 		);
 	}
 	// stack based
@@ -251,7 +260,8 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 			},
 			n,
 			T,
-			N
+			N,
+			shape
 		);
 	}
 	else if (what == "stack_based_list") {
@@ -265,7 +275,8 @@ void linarr_crossings(uint64_t argc, char *argv[]) noexcept
 			},
 			n,
 			T,
-			N
+			N,
+			shape
 		);
 	}
 	else {
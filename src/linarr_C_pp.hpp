@@ -32,6 +32,9 @@
 #include <string>
 #include <set>
 
+// common includes
+#include "tree_shape.hpp"
+
 namespace profiling {
 namespace linarr_C {
 
@@ -60,6 +63,10 @@ public:
 	{
 		return m_T;
 	}
+	[[nodiscard]] const generate::tree_shape& get_shape() const noexcept
+	{
+		return m_shape;
+	}
 
 	void print_usage() const noexcept;
 
@@ -99,6 +106,10 @@ private:
 		 "stack_based",
 		 "stack_based_list"}
 	);
+
+	// shape of the trees
+	generate::tree_shape m_shape;
+
 	uint64_t m_argc;
 	char **m_argv;
 };
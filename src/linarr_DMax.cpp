@@ -30,7 +30,6 @@
 #include <string>
 
 // lal includes
-#include <lal/generate/tree_generator_type.hpp>
 #include <lal/graphs/conversions.hpp>
 #include <lal/linarr/D/DMax.hpp>
 #include <lal/graphs/free_tree.hpp>
@@ -38,6 +37,7 @@
 
 // common includes
 #include "time.hpp"
+#include "generate_tree_shapes.hpp"
 #include "linarr_DMax_pp.hpp"
 
 namespace profiling {
@@ -74,14 +74,14 @@ double exe_algo(const tree_t& t, const function_t& A, const uint64_t R) noexcept
 
 template <class tree_t, typename function_t>
 void profile_algo(
-	const function_t& A, const uint64_t n, const uint64_t T, const uint64_t R
+	const function_t& A,
+	const uint64_t n,
+	const uint64_t T,
+	const uint64_t R,
+	const generate::tree_shape& shape
 ) noexcept
 {
-	lal::generate::tree_generator_type_t<
-		lal::generate::random_t,
-		lal::generate::unlabelled_t,
-		tree_t>
-		Gen(n, 1234);
+	generate::tree_shape_generator<tree_t> Gen(n, shape, 1234);
 	Gen.deactivate_all_postprocessing_actions();
 
 	double totallocal = 0.0;
@@ -133,23 +133,26 @@ void linarr_maximum_D(uint64_t argc, char *argv[]) noexcept
 	if (parser.get_mode() == "automatic") {
 		const uint64_t n = parser.get_n();
 		const uint64_t T = parser.get_T();
+		const generate::tree_shape& shape = parser.get_shape();
 
 		if (what == "projective") {
 			linarr_DMax::profile_algo<lal::graphs::rooted_tree>(
-				projective, n, T, R
+				projective, n, T, R, shape
 			);
 		}
 		else if (what == "planar") {
-			linarr_DMax::profile_algo<lal::graphs::free_tree>(planar, n, T, R);
+			linarr_DMax::profile_algo<lal::graphs::free_tree>(
+				planar, n, T, R, shape
+			);
 		}
 		else if (what == "bipartite") {
 			linarr_DMax::profile_algo<lal::graphs::free_tree>(
-				bipartite, n, T, R
+				bipartite, n, T, R, shape
 			);
 		}
 		else if (what == "1_eq_thistle") {
 			linarr_DMax::profile_algo<lal::graphs::free_tree>(
-				onethistle, n, T, R
+				onethistle, n, T, R, shape
 			);
 		}
 		else {
@@ -34,6 +34,9 @@
 // lal includes
 #include <lal/basic_types.hpp>
 
+// common includes
+#include "tree_shape.hpp"
+
 namespace profiling {
 namespace linarr_DMax {
 
@@ -70,6 +73,10 @@ public:
 	{
 		return m_R;
 	}
+	[[nodiscard]] const generate::tree_shape& get_shape() const noexcept
+	{
+		return m_shape;
+	}
 
 	void print_usage() const noexcept;
 
@@ -112,6 +119,9 @@ private:
 	lal::head_vector m_hv;
 	bool m_has_hv = false;
 
+	// shape of the trees
+	generate::tree_shape m_shape;
+
 	uint64_t m_argc;
 	char **m_argv;
 };
@@ -31,13 +31,13 @@
 #include <string>
 
 // lal includes
-#include <lal/generate/tree_generator_type.hpp>
 #include <lal/linarr/D/Dmin.hpp>
 #include <lal/graphs/free_tree.hpp>
 #include <lal/graphs/rooted_tree.hpp>
 
 // common includes
 #include "time.hpp"
+#include "generate_tree_shapes.hpp"
 #include "linarr_Dmin_pp.hpp"
 
 namespace profiling {
@@ -62,8 +62,12 @@ void output_execution_time(
 }
 
 template <class tree_t, typename Callable>
-void profile_algo(const Callable& A, const uint64_t n, const uint64_t T)
-	noexcept
+void profile_algo(
+	const Callable& A,
+	const uint64_t n,
+	const uint64_t T,
+	const generate::tree_shape& shape
+) noexcept
 {
 	static_assert(std::is_constructible_v<
 				  std::function<std::pair<
@@ -73,11 +77,7 @@ void profile_algo(const Callable& A, const uint64_t n, const uint64_t T)
 
 	double totallocal = 0.0;
 
-	lal::generate::tree_generator_type_t<
-		lal::generate::random_t,
-		lal::generate::unlabelled_t,
-		tree_t>
-		Gen(n, 1234);
+	generate::tree_shape_generator<tree_t> Gen(n, shape, 1234);
 	Gen.deactivate_all_postprocessing_actions();
 
 	const auto beginglobal = profiling::now();
@@ -115,6 +115,7 @@ void linarr_minimum_D(uint64_t argc, char *argv[]) noexcept
 	const std::string what = parser.get_algo();
 	const uint64_t n = parser.get_n();
 	const uint64_t T = parser.get_T();
+	const generate::tree_shape& shape = parser.get_shape();
 
 	if (what == "unconstrained_YS") {
 		linarr_Dmin::profile_algo<lal::graphs::free_tree>(
@@ -125,7 +126,8 @@ void linarr_minimum_D(uint64_t argc, char *argv[]) noexcept
 				);
 			},
 			n,
-			T
+			T,
+			shape
 		);
 	}
 	else if (what == "unconstrained_FC") {
@@ -137,7 +139,8 @@ void linarr_minimum_D(uint64_t argc, char *argv[]) noexcept
 				);
 			},
 			n,
-			T
+			T,
+			shape
 		);
 	}
 	else if (what == "projective_AEF") {
@@ -151,7 +154,8 @@ void linarr_minimum_D(uint64_t argc, char *argv[]) noexcept
 				);
 			},
 			n,
-			T
+			T,
+			shape
 		);
 	}
 	else if (what == "projective_HS") {
@@ -164,7 +168,8 @@ void linarr_minimum_D(uint64_t argc, char *argv[]) noexcept
 				);
 			},
 			n,
-			T
+			T,
+			shape
 		);
 	}
 	else if (what == "planar_AEF") {
@@ -176,7 +181,8 @@ void linarr_minimum_D(uint64_t argc, char *argv[]) noexcept
 				);
 			},
 			n,
-			T
+			T,
+			shape
 		);
 	}
 	else if (what == "planar_HS") {
@@ -188,7 +194,8 @@ void linarr_minimum_D(uint64_t argc, char *argv[]) noexcept
 				);
 			},
 			n,
-			T
+			T,
+			shape
 		);
 	}
 	else {
@@ -64,6 +64,7 @@ void linarr_Dmin_pp::print_usage() const noexcept
 	std::cout << "          " << algo << '\n';
 	}
 	std::cout << '\n';
+	generate::print_tree_shape_usage();
 	// clang-format on
 }
 
@@ -95,6 +96,14 @@ int linarr_Dmin_pp::parse_params() noexcept
 			m_gen_algo = std::string(m_argv[i + 1]);
 			++i;
 		}
+		else if (param == "-shape") {
+			if (not generate::parse_tree_shape(m_argv[i + 1], m_shape)) {
+				std::cerr << "Error: wrong value for parameter '-shape'.\n";
+				std::cerr << "    Value: '" << m_argv[i + 1] << "'\n";
+				return 2;
+			}
+			++i;
+		}
 		else {
 			std::cerr << "Error: unrecognised option\n";
 			std::cerr << "    " << param << '\n';
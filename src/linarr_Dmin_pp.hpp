@@ -32,6 +32,9 @@
 #include <string>
 #include <set>
 
+// common includes
+#include "tree_shape.hpp"
+
 namespace profiling {
 namespace linarr_Dmin {
 
@@ -53,6 +56,10 @@ public:
 	{
 		return m_T;
 	}
+	[[nodiscard]] const generate::tree_shape& get_shape() const noexcept
+	{
+		return m_shape;
+	}
 
 	void print_usage() const noexcept;
 
@@ -86,6 +93,10 @@ private:
 		 "planar_AEF",
 		 "planar_HS"}
 	);
+
+	// shape of the trees
+	generate::tree_shape m_shape;
+
 	uint64_t m_argc;
 	char **m_argv;
 };
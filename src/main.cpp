@@ -42,6 +42,8 @@ void numeric_rational(uint64_t argc, char *argv[]) noexcept;
 void properties_variance_C_graph(uint64_t argc, char *argv[]) noexcept;
 void properties_centroid_tree(uint64_t argc, char *argv[]) noexcept;
 void properties_centre_tree(uint64_t argc, char *argv[]) noexcept;
+void properties_suite_tree(uint64_t argc, char *argv[]) noexcept;
+void properties_D_rla_graph(uint64_t argc, char *argv[]) noexcept;
 void utilities_tree_isomorphism(uint64_t argc, char *argv[]) noexcept;
 void detail_sorting_algorithms(uint64_t argc, char *argv[]) noexcept;
 void conversion(uint64_t argc, char *argv[]) noexcept;
@@ -86,6 +88,12 @@ void usage() noexcept
 	std::cout << "    properties_centre_tree : Profile the algorithm for the computation\n";
 	std::cout << "        of the centre of a tree.\n";
 	std::cout << '\n';
+	std::cout << "    properties_suite : Profile the computation of several properties\n";
+	std::cout << "        of trees, separately and in a single traversal.\n";
+	std::cout << '\n';
+	std::cout << "    properties_D_rla : Profile the computation of the expectation\n";
+	std::cout << "        and the variance of the sum of edge lengths.\n";
+	std::cout << '\n';
 	std::cout << "    utilities_isomorphism : Profile the algorithms for the tree\n";
 	std::cout << "        isomorphism test.\n";
 	std::cout << '\n';
@@ -140,6 +148,12 @@ int main(int argc, char *argv[]) noexcept
 	else if (first == "properties_centre_tree") {
 		profiling::properties_centre_tree(_argc - 2, &argv[2]);
 	}
+	else if (first == "properties_suite") {
+		profiling::properties_suite_tree(_argc - 2, &argv[2]);
+	}
+	else if (first == "properties_D_rla") {
+		profiling::properties_D_rla_graph(_argc - 2, &argv[2]);
+	}
 	else if (first == "utilities_isomorphism") {
 		profiling::utilities_tree_isomorphism(_argc - 2, &argv[2]);
 	}
@@ -0,0 +1,90 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "mapped_file.hpp"
+
+// C++ includes
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+// C includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace profiling {
+namespace io {
+
+mapped_file::~mapped_file() noexcept
+{
+	if (m_size > 0) {
+		munmap(const_cast<char *>(m_data), m_size);
+	}
+}
+
+bool mapped_file::open(const std::string& path) noexcept
+{
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd == -1) {
+		std::cerr << "Error: cannot open file '" << path
+				  << "': " << std::strerror(errno) << '\n';
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) == -1) {
+		std::cerr << "Error: cannot read the size of file '" << path
+				  << "': " << std::strerror(errno) << '\n';
+		close(fd);
+		return false;
+	}
+
+	m_size = static_cast<std::size_t>(st.st_size);
+	if (m_size == 0) {
+		close(fd);
+		return true;
+	}
+
+	void * const data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED) {
+		std::cerr << "Error: cannot map file '" << path
+				  << "': " << std::strerror(errno) << '\n';
+		m_size = 0;
+		return false;
+	}
+
+	// the file is read once, from beginning to end
+	madvise(data, m_size, MADV_SEQUENTIAL);
+	m_data = static_cast<const char *>(data);
+	return true;
+}
+
+} // namespace io
+} // namespace profiling
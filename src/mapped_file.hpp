@@ -0,0 +1,109 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace profiling {
+namespace io {
+
+/*
+ * Read-only memory mapping of a whole file.
+ *
+ * The contents are paged in by the operating system as they are read, so
+ * files much larger than the available memory can be scanned, and nothing
+ * is copied to the heap.
+ */
+class mapped_file {
+public:
+
+	mapped_file() noexcept = default;
+	~mapped_file() noexcept;
+
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator= (const mapped_file&) = delete;
+
+	// Maps the file at 'path'. Returns false, after printing the reason,
+	// when the file cannot be mapped.
+	[[nodiscard]] bool open(const std::string& path) noexcept;
+
+	[[nodiscard]] const char *begin() const noexcept
+	{
+		return m_data;
+	}
+	[[nodiscard]] const char *end() const noexcept
+	{
+		return m_data + m_size;
+	}
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return m_size;
+	}
+
+private:
+
+	const char *m_data = nullptr;
+	std::size_t m_size = 0;
+};
+
+/*
+ * Calls f(x) for every unsigned integer x in [begin,end), in order. Integers
+ * are separated by whitespace. Returns false if some token is not an
+ * unsigned integer. Nothing is allocated.
+ */
+template <typename Callable>
+[[nodiscard]] bool
+for_each_integer(const char *begin, const char * const end, Callable&& f)
+{
+	while (true) {
+		while (begin != end and (*begin == ' ' or *begin == '\n' or
+								 *begin == '\t' or *begin == '\r')) {
+			++begin;
+		}
+		if (begin == end) {
+			return true;
+		}
+
+		uint64_t x;
+		const auto [ptr, ec] = std::from_chars(begin, end, x);
+		if (ec != std::errc() or
+			(ptr != end and *ptr != ' ' and *ptr != '\n' and *ptr != '\t' and
+			 *ptr != '\r')) {
+			return false;
+		}
+		f(x);
+		begin = ptr;
+	}
+}
+
+} // namespace io
+} // namespace profiling
@@ -0,0 +1,131 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "numeric_accumulator.hpp"
+
+// C++ includes
+#include <algorithm>
+
+namespace profiling {
+namespace numeric {
+
+rational_accumulator::rational_accumulator(const uint64_t threshold) noexcept
+	: m_threshold(threshold),
+	  m_next_normalization(threshold)
+{
+	mpz_inits(m_num, m_den, m_aux, nullptr);
+	mpz_set_ui(m_den, 1);
+}
+
+rational_accumulator::~rational_accumulator() noexcept
+{
+	mpz_clears(m_num, m_den, m_aux, nullptr);
+}
+
+void rational_accumulator::set(const int64_t n, const uint64_t d) noexcept
+{
+	mpz_set_si(m_num, n);
+	mpz_set_ui(m_den, d);
+	m_num_normalizations = 0;
+	m_max_num_bits = 0;
+	m_max_den_bits = 0;
+	m_next_normalization = m_threshold;
+	check_size();
+}
+
+void rational_accumulator::add(const int64_t n, const uint64_t d) noexcept
+{
+	const uint64_t abs_n =
+		(n < 0 ? 0 - static_cast<uint64_t>(n) : static_cast<uint64_t>(n));
+
+	if (d == 1) {
+		// num/den + n = (num + n*den)/den
+		if (n < 0) {
+			mpz_submul_ui(m_num, m_den, abs_n);
+		}
+		else {
+			mpz_addmul_ui(m_num, m_den, abs_n);
+		}
+	}
+	else if (mpz_divisible_ui_p(m_den, d)) {
+		// num/den + n/d = (num + n*(den/d))/den
+		mpz_divexact_ui(m_aux, m_den, d);
+		if (n < 0) {
+			mpz_submul_ui(m_num, m_aux, abs_n);
+		}
+		else {
+			mpz_addmul_ui(m_num, m_aux, abs_n);
+		}
+	}
+	else {
+		// num/den + n/d = (num*d + n*den)/(den*d)
+		mpz_mul_ui(m_num, m_num, d);
+		if (n < 0) {
+			mpz_submul_ui(m_num, m_den, abs_n);
+		}
+		else {
+			mpz_addmul_ui(m_num, m_den, abs_n);
+		}
+		mpz_mul_ui(m_den, m_den, d);
+	}
+	check_size();
+}
+
+void rational_accumulator::normalize() noexcept
+{
+	mpz_gcd(m_aux, m_num, m_den);
+	if (mpz_cmp_ui(m_aux, 1) != 0) {
+		mpz_divexact(m_num, m_num, m_aux);
+		mpz_divexact(m_den, m_den, m_aux);
+	}
+	++m_num_normalizations;
+
+	const uint64_t bits =
+		std::max(mpz_sizeinbase(m_num, 2), mpz_sizeinbase(m_den, 2));
+	m_next_normalization = bits + m_threshold;
+}
+
+void rational_accumulator::get(mpq_ptr q) noexcept
+{
+	normalize();
+	mpq_set_num(q, m_num);
+	mpq_set_den(q, m_den);
+}
+
+void rational_accumulator::check_size() noexcept
+{
+	const uint64_t num_bits = mpz_sizeinbase(m_num, 2);
+	const uint64_t den_bits = mpz_sizeinbase(m_den, 2);
+	m_max_num_bits = std::max(m_max_num_bits, num_bits);
+	m_max_den_bits = std::max(m_max_den_bits, den_bits);
+	if (num_bits > m_next_normalization or den_bits > m_next_normalization) {
+		normalize();
+	}
+}
+
+} // namespace numeric
+} // namespace profiling
@@ -0,0 +1,110 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+
+// gmp includes
+#include <gmp.h>
+
+namespace profiling {
+namespace numeric {
+
+/*
+ * Sum of rational numbers with deferred canonicalisation.
+ *
+ * The value is kept as a numerator and a denominator that are not reduced
+ * after every addition. The gcd is only removed when the value is read, or
+ * when the numerator or the denominator has grown by more than a threshold
+ * (in bits) since the last normalisation. The trigger is relative so that a
+ * value whose reduced form is already larger than the threshold is not
+ * normalised on every addition.
+ * Adding a term whose denominator divides the current denominator (e.g., an
+ * integer) does not make the denominator grow.
+ */
+class rational_accumulator {
+public:
+
+	rational_accumulator(const uint64_t threshold) noexcept;
+	~rational_accumulator() noexcept;
+
+	// Sets the value to n/d. The denominator must be positive.
+	void set(const int64_t n, const uint64_t d) noexcept;
+
+	// Adds n/d to the value. The denominator must be positive.
+	void add(const int64_t n, const uint64_t d) noexcept;
+
+	// Removes the gcd of the numerator and the denominator.
+	void normalize() noexcept;
+
+	// Writes the value, in canonical form, into 'q'.
+	void get(mpq_ptr q) noexcept;
+
+	// Number of times the value has been normalised since the last set().
+	[[nodiscard]] uint64_t get_num_normalizations() const noexcept
+	{
+		return m_num_normalizations;
+	}
+	// Largest size (in bits) of the numerator since the last set().
+	[[nodiscard]] uint64_t get_max_numerator_bits() const noexcept
+	{
+		return m_max_num_bits;
+	}
+	// Largest size (in bits) of the denominator since the last set().
+	[[nodiscard]] uint64_t get_max_denominator_bits() const noexcept
+	{
+		return m_max_den_bits;
+	}
+
+private:
+
+	// Updates the statistics and normalises if the threshold is exceeded.
+	void check_size() noexcept;
+
+	// numerator
+	mpz_t m_num;
+	// denominator, always positive
+	mpz_t m_den;
+	// auxiliary value
+	mpz_t m_aux;
+
+	// growth (in bits) of the numerator and denominator between two
+	// normalisations
+	const uint64_t m_threshold;
+	// size (in bits) of the numerator or denominator past which the value
+	// is normalised
+	uint64_t m_next_normalization;
+
+	uint64_t m_num_normalizations = 0;
+	uint64_t m_max_num_bits = 0;
+	uint64_t m_max_den_bits = 0;
+};
+
+} // namespace numeric
+} // namespace profiling
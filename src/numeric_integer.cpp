@@ -25,119 +25,540 @@
  *
  ***********************************************************************/
 
-// C*+ includes
+// C++ includes
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <random>
 
 // lal includes
 #include <lal/numeric/integer.hpp>
 #include <lal/numeric/output.hpp>
 
 // common includes
+#include "gmp_memory.hpp"
+#include "numeric_loops.hpp"
+#include "numeric_pp.hpp"
+#include "numeric_small.hpp"
 #include "time.hpp"
 
 namespace profiling {
+namespace numeric {
 
-void numeric_integer(
-	[[maybe_unused]] uint64_t argc, [[maybe_unused]] char *argv[]
+namespace {
+
+// Prevents the compiler from discarding the computation of 'v'.
+template <typename T>
+inline void do_not_optimize(const T& v) noexcept
+{
+	asm volatile("" : : "r"(&v) : "memory");
+}
+
+// A random number of (approximately) 'bits' bits, in base 10.
+[[nodiscard]] std::string
+random_digits(const uint64_t bits, std::mt19937_64& gen) noexcept
+{
+	// log10(2)
+	const double digits_per_bit = 0.30102999566398120;
+	const std::size_t digits = std::max<std::size_t>(
+		1, static_cast<std::size_t>(static_cast<double>(bits) * digits_per_bit)
+	);
+
+	std::uniform_int_distribution<int> U(0, 9);
+	std::string s(digits, '0');
+	s[0] = static_cast<char>('1' + U(gen) % 9);
+	for (std::size_t i = 1; i < digits; ++i) {
+		s[i] = static_cast<char>('0' + U(gen));
+	}
+	return s;
+}
+
+// Measurement of one cell of the matrix.
+struct cell {
+	double ns_per_op = 0;
+	double allocs_per_op = 0;
+};
+
+// Executes 'op' repeatedly, doubling the number of repetitions until the
+// total time is at least 'min_time' milliseconds. Allocations are those made
+// through GMP's memory functions (allocations and reallocations).
+template <typename F>
+[[nodiscard]] cell measure(const F& op, const double min_time) noexcept
+{
+	uint64_t reps = 1;
+	while (true) {
+		gmp_memory::reset_counters();
+		const profiling::time_point begin = profiling::now();
+		for (uint64_t r = 0; r < reps; ++r) {
+			op();
+		}
+		const profiling::time_point end = profiling::now();
+		const double total = profiling::elapsed_time(begin, end);
+
+		if (total >= min_time) {
+			const gmp_memory::counters c = gmp_memory::get_counters();
+			const double R = static_cast<double>(reps);
+			return {
+				total * 1'000'000.0 / R,
+				static_cast<double>(c.allocations + c.reallocations) / R
+			};
+		}
+		reps *= 2;
+	}
+}
+
+// Measures 'op' applied in place on a copy of 'a'. Resetting the copy is
+// measured separately and its cost subtracted.
+template <typename F>
+[[nodiscard]] cell measure_in_place(
+	const lal::numeric::integer& a, const F& op, const double min_time
+) noexcept
+{
+	lal::numeric::integer c = a;
+	const cell with_op = measure(
+		[&]()
+		{
+			c = a;
+			op(c);
+			do_not_optimize(c);
+		},
+		min_time
+	);
+	const cell reset = measure(
+		[&]()
+		{
+			c = a;
+			do_not_optimize(c);
+		},
+		min_time
+	);
+	return {
+		std::max(0.0, with_op.ns_per_op - reset.ns_per_op),
+		std::max(0.0, with_op.allocs_per_op - reset.allocs_per_op)
+	};
+}
+
+// Measures the binary operation 'op' with operands 'a' and 'b'. Returns
+// false if the operation has no in-place form and 'in_place' is true.
+template <typename operand_t>
+[[nodiscard]] bool measure_binary(
+	const std::string& op,
+	const lal::numeric::integer& a,
+	const operand_t& b,
+	const bool in_place,
+	const double min_time,
+	cell& res
+) noexcept
+{
+	if (op == "+") {
+		if (in_place) {
+			res = measure_in_place(
+				a,
+				[&](lal::numeric::integer& c)
+				{
+					c += b;
+				},
+				min_time
+			);
+		}
+		else {
+			res = measure(
+				[&]()
+				{
+					do_not_optimize(a + b);
+				},
+				min_time
+			);
+		}
+		return true;
+	}
+	if (op == "-") {
+		if (in_place) {
+			res = measure_in_place(
+				a,
+				[&](lal::numeric::integer& c)
+				{
+					c -= b;
+				},
+				min_time
+			);
+		}
+		else {
+			res = measure(
+				[&]()
+				{
+					do_not_optimize(a - b);
+				},
+				min_time
+			);
+		}
+		return true;
+	}
+	if (op == "*") {
+		if (in_place) {
+			res = measure_in_place(
+				a,
+				[&](lal::numeric::integer& c)
+				{
+					c *= b;
+				},
+				min_time
+			);
+		}
+		else {
+			res = measure(
+				[&]()
+				{
+					do_not_optimize(a * b);
+				},
+				min_time
+			);
+		}
+		return true;
+	}
+	if (op == "/") {
+		if (in_place) {
+			res = measure_in_place(
+				a,
+				[&](lal::numeric::integer& c)
+				{
+					c /= b;
+				},
+				min_time
+			);
+		}
+		else {
+			res = measure(
+				[&]()
+				{
+					do_not_optimize(a / b);
+				},
+				min_time
+			);
+		}
+		return true;
+	}
+	if (op == "%") {
+		if (in_place) {
+			return false;
+		}
+		res = measure(
+			[&]()
+			{
+				do_not_optimize(a % b);
+			},
+			min_time
+		);
+		return true;
+	}
+	if (op == "pow") {
+		if (in_place) {
+			res = measure_in_place(
+				a,
+				[&](lal::numeric::integer& c)
+				{
+					c.powt(b);
+				},
+				min_time
+			);
+		}
+		else {
+			res = measure(
+				[&]()
+				{
+					do_not_optimize(a.pow(b));
+				},
+				min_time
+			);
+		}
+		return true;
+	}
+	if (op == "compare") {
+		if (in_place) {
+			return false;
+		}
+		res = measure(
+			[&]()
+			{
+				do_not_optimize(a < b);
+			},
+			min_time
+		);
+		return true;
+	}
+	return false;
+}
+
+// Measures the conversions from and to strings of 'a', whose decimal
+// representation is 'str'.
+[[nodiscard]] bool measure_conversion(
+	const std::string& op,
+	const lal::numeric::integer& a,
+	const std::string& str,
+	const bool in_place,
+	const double min_time,
+	cell& res
+) noexcept
+{
+	if (op == "to_string") {
+		std::string s;
+		if (in_place) {
+			res = measure(
+				[&]()
+				{
+					a.to_string(s);
+					do_not_optimize(s);
+				},
+				min_time
+			);
+		}
+		else {
+			res = measure(
+				[&]()
+				{
+					do_not_optimize(a.to_string());
+				},
+				min_time
+			);
+		}
+		return true;
+	}
+	if (op == "from_string") {
+		if (in_place) {
+			return false;
+		}
+		res = measure(
+			[&]()
+			{
+				do_not_optimize(lal::numeric::integer(str));
+			},
+			min_time
+		);
+		return true;
+	}
+	return false;
+}
+
+void print_cell(const bool measured, const cell& c) noexcept
+{
+	if (not measured) {
+		std::cout << std::setw(16) << '-' << std::setw(12) << '-';
+		return;
+	}
+	std::cout << std::setw(16) << c.ns_per_op << std::setw(12)
+			  << c.allocs_per_op;
+}
+
+void print_row(
+	const std::string& op,
+	const std::string& operands,
+	const bool has_temp,
+	const cell& temp,
+	const bool has_in_place,
+	const cell& in_place
 ) noexcept
 {
+	std::cout << std::setw(12) << op << std::setw(20) << operands;
+	print_cell(has_temp, temp);
+	print_cell(has_in_place, in_place);
+	std::cout << '\n';
+}
+
+void matrix(const numeric_pp& parser) noexcept
+{
+	const double min_time = parser.get_min_time();
+	std::mt19937_64 gen(1234);
+	std::uniform_int_distribution<uint64_t> U(1, (1ull << 62) - 1);
+
+	gmp_memory::install_counting();
+
+	std::cout << std::fixed << std::setprecision(2);
+	for (const uint64_t bits : parser.get_bits()) {
+		const std::string str = random_digits(bits, gen);
+		const lal::numeric::integer a(str);
+
+		std::cout << "------------------------\n";
+		std::cout << "Operand size: " << bits << " bits\n";
+		std::cout << std::setw(12) << "operation" << std::setw(20)
+				  << "operands" << std::setw(28) << "temporary"
+				  << std::setw(28) << "in-place" << '\n';
+		std::cout << std::setw(32) << ' ' << std::setw(16) << "ns/op"
+				  << std::setw(12) << "allocs/op" << std::setw(16)
+				  << "ns/op" << std::setw(12) << "allocs/op" << '\n';
+
+		for (const std::string& op : parser.get_ops()) {
+			cell temp, in_place;
+
+			if (op == "to_string" or op == "from_string") {
+				const bool t = measure_conversion(
+					op, a, str, false, min_time, temp
+				);
+				const bool i = measure_conversion(
+					op, a, str, true, min_time, in_place
+				);
+				print_row(op, "integer", t, temp, i, in_place);
+				continue;
+			}
+
+			// integral operand: the exponent of pow is always small
+			const uint64_t b_integral = (op == "pow" ? 3 : U(gen));
+
+			// integer operand
+			lal::numeric::integer b_integer;
+			if (op == "pow") {
+				b_integer = lal::numeric::integer(3);
+			}
+			else if (op == "/" or op == "%") {
+				// divisors have half the size of the dividend so that
+				// quotients and remainders are not trivial
+				b_integer = lal::numeric::integer(random_digits(bits / 2, gen));
+			}
+			else if (op == "compare") {
+				// equal numbers need all the digits to be compared
+				b_integer = a;
+			}
+			else {
+				b_integer = lal::numeric::integer(random_digits(bits, gen));
+			}
+
+			{
+				const bool t = measure_binary(
+					op, a, b_integral, false, min_time, temp
+				);
+				const bool i = measure_binary(
+					op, a, b_integral, true, min_time, in_place
+				);
+				print_row(op, "integer op integral", t, temp, i, in_place);
+			}
+			{
+				const bool t = measure_binary(
+					op, a, b_integer, false, min_time, temp
+				);
+				const bool i = measure_binary(
+					op, a, b_integer, true, min_time, in_place
+				);
+				print_row(op, "integer op integer", t, temp, i, in_place);
+			}
+		}
+	}
+
+	gmp_memory::uninstall();
+}
+
+// A top-level call of the multi-threaded loops: every loop once, with
+// integral operands. The divisions bring 4999! back down to 1.
+void call() noexcept
+{
+	lal::numeric::integer i = 1;
+	for (uint64_t f = 1; f < 5000; ++f) {
+		i = (i + f);
+	}
+	i = 1;
+	for (uint64_t f = 1; f < 5000; ++f) {
+		i = (i - f);
+	}
+	i = 1;
+	for (uint64_t f = 1; f < 5000; ++f) {
+		i = (i * f);
+	}
+	for (uint64_t f = 1; f < 5000; ++f) {
+		i = (i / f);
+	}
+}
 
+template <class integer_t>
+void loops(loop_times& times) noexcept
+{
 	profiling::time_point begin, end;
 	double total;
 	// additions
 	{
-		std::cout << "------------------------\n";
+		times.emplace_back("", 0.0);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::integer i = 1;
+			integer_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i = (i + f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Additions (integer + integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Additions (integer + integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::integer i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			integer_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i = (i + f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Additions (integer + integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Additions (integer + integer)", total);
 	}
 
 	// substractions
 	{
-		std::cout << "------------------------\n";
+		times.emplace_back("", 0.0);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::integer i = 1;
+			integer_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i = (i - f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Subtractions (integer - integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Subtractions (integer - integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::integer i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			integer_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i = (i - f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Subtractions (integer - integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Subtractions (integer - integer)", total);
 	}
 
 	// multiplications
 	{
-		std::cout << "------------------------\n";
+		times.emplace_back("", 0.0);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::integer i = 1;
+			integer_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i = (i * f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Multiplications (integer * integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Multiplications (integer * integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::integer i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			integer_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i = (i * f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Multiplications (integer * integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Multiplications (integer * integer)", total);
 	}
 
 	// divisions
 	{
-		std::cout << "------------------------\n";
+		times.emplace_back("", 0.0);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::integer i = std::string(
+			integer_t i = std::string(
 				"99999999999999999999999999999999999999999999999999999999999999"
 				"99999999999999999999999999999999999999999999999999999999999999"
 				"99999999999999999999999999999999999999999999999999999999999999"
@@ -176,20 +597,69 @@ void numeric_integer(
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Divisions (integer / integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Divisions (integer / integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::integer i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			integer_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i = (i / f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Divisions (integer / integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Divisions (integer / integer)", total);
+	}
+}
+
+} // namespace
+
+} // namespace numeric
+
+void numeric_integer(uint64_t argc, char *argv[]) noexcept
+{
+	numeric::numeric_pp parser(argc, argv);
+	{
+		if (parser.parse_params() > 0) {
+			return;
+		}
+		if (parser.check_errors() > 0) {
+			return;
+		}
+		if (parser.get_mode() == "accumulate") {
+			std::cout << "Error: mode '" << parser.get_mode()
+					  << "' is only available for numeric_rational.\n";
+			return;
+		}
+	}
+
+	if (parser.has_threads()) {
+		numeric::print_thread_scaling(
+			parser.get_threads(), parser.get_calls(), numeric::call
+		);
+	}
+	else if (parser.get_mode() == "loops") {
+		const std::string& impl = parser.get_impl();
+		numeric::loop_times gmp, small;
+		if (impl != "inline") {
+			numeric::loops<lal::numeric::integer>(gmp);
+		}
+		if (impl != "gmp") {
+			numeric::loops<numeric::small_integer>(small);
+		}
+
+		if (impl == "gmp") {
+			numeric::print_loop_times(gmp);
+		}
+		else if (impl == "inline") {
+			numeric::print_loop_times(small);
+		}
+		else {
+			numeric::print_loop_times(gmp, small);
+		}
+	}
+	else {
+		numeric::matrix(parser);
 	}
 }
 
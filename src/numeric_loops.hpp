@@ -0,0 +1,157 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// common includes
+#include "gmp_memory.hpp"
+#include "time.hpp"
+
+namespace profiling {
+namespace numeric {
+
+// Times (in ms) of the loops of the numeric profilers, in the order in which
+// they were executed. An empty name separates groups of loops.
+typedef std::vector<std::pair<std::string, double>> loop_times;
+
+// Prints the times of the loops of one implementation.
+inline void print_loop_times(const loop_times& times) noexcept
+{
+	for (const auto& [name, total] : times) {
+		if (name.empty()) {
+			std::cout << "------------------------\n";
+		}
+		else {
+			std::cout << name << ": " << profiling::time_to_str(total) << '\n';
+		}
+	}
+}
+
+// Prints the times of the loops of the GMP and the inline implementations.
+// Both must contain the same loops.
+inline void
+print_loop_times(const loop_times& gmp, const loop_times& small) noexcept
+{
+	for (std::size_t i = 0; i < gmp.size(); ++i) {
+		const auto& [name, total_gmp] = gmp[i];
+		if (name.empty()) {
+			std::cout << "------------------------\n";
+			continue;
+		}
+		const double total_small = small[i].second;
+		std::cout << name << ":\n";
+		std::cout << "    gmp:     " << profiling::time_to_str(total_gmp)
+				  << '\n';
+		std::cout << "    inline:  " << profiling::time_to_str(total_small)
+				  << '\n';
+		std::cout << "    speedup: " << total_gmp / total_small << '\n';
+	}
+}
+
+namespace detail {
+
+// Executes 'calls' calls to 'f' in each of 'num_threads' threads. Returns
+// the elapsed time.
+template <typename F>
+[[nodiscard]] double run_calls(
+	const uint64_t num_threads,
+	const uint64_t calls,
+	const bool use_arena,
+	const F& f
+) noexcept
+{
+	const profiling::time_point begin = profiling::now();
+#pragma omp parallel num_threads(static_cast<int>(num_threads))
+	{
+		for (uint64_t c = 0; c < calls; ++c) {
+			if (use_arena) {
+				const gmp_memory::arena_scope scope;
+				f();
+			}
+			else {
+				f();
+			}
+		}
+	}
+	const profiling::time_point end = profiling::now();
+	return profiling::elapsed_time(begin, end);
+}
+
+} // namespace detail
+
+// Executes 'calls' top-level calls to 'f' in each thread, for 1, 2, 4, ...,
+// 'max_threads' threads, with GMP's default memory functions and with a
+// per-thread arena reset after every call. Prints the throughput.
+template <typename F>
+void print_thread_scaling(
+	const uint64_t max_threads, const uint64_t calls, const F& f
+) noexcept
+{
+	double base_malloc = 0;
+	double base_arena = 0;
+
+	for (uint64_t t = 1;; t = std::min(2 * t, max_threads)) {
+		const double total_malloc = detail::run_calls(t, calls, false, f);
+
+		gmp_memory::install_arena();
+		const double total_arena = detail::run_calls(t, calls, true, f);
+		gmp_memory::uninstall();
+
+		const double C = static_cast<double>(t * calls);
+		const double thr_malloc = C / (total_malloc / 1000.0);
+		const double thr_arena = C / (total_arena / 1000.0);
+		if (t == 1) {
+			base_malloc = thr_malloc;
+			base_arena = thr_arena;
+		}
+
+		std::cout << "------------------------\n";
+		std::cout << "Threads: " << t << '\n';
+		std::cout << "    Without arena: "
+				  << profiling::time_to_str(total_malloc) << ", " << thr_malloc
+				  << " calls/s, speedup " << thr_malloc / base_malloc << '\n';
+		std::cout << "    With arena:    "
+				  << profiling::time_to_str(total_arena) << ", " << thr_arena
+				  << " calls/s, speedup " << thr_arena / base_arena << '\n';
+		std::cout << "    Arena over default: " << thr_arena / thr_malloc
+				  << '\n';
+
+		if (t == max_threads) {
+			break;
+		}
+	}
+}
+
+} // namespace numeric
+} // namespace profiling
@@ -0,0 +1,219 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "numeric_pp.hpp"
+
+// C++ includes
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace profiling {
+namespace numeric {
+
+numeric_pp::numeric_pp(uint64_t argc, char *argv[]) noexcept
+	: m_argc(argc),
+	  m_argv(argv)
+{ }
+
+void numeric_pp::print_usage() const noexcept
+{
+	// clang-format off
+	std::cout << "Profiling -- Operations with arbitrary precision numbers\n";
+	std::cout << "========================================================\n";
+	std::cout << '\n';
+	std::cout << "This program's options are the following:\n";
+	std::cout << "    Those marked with [*] are mandatory for all execution modes.\n";
+	std::cout << "    Those marked with [i] are mandatory for execution mode i.\n";
+	std::cout << "    Those marked with [?] are optional.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -mode m\n";
+	std::cout << "          Indicate the mode in which to execute the profiler.\n";
+	std::cout << "          [1] loops: the fixed loops of additions, subtractions,\n";
+	std::cout << "              multiplications and divisions.\n";
+	std::cout << "          [2] matrix: operand sizes x operations (integers only).\n";
+	std::cout << "          [3] accumulate: sums of rationals canonicalised after\n";
+	std::cout << "              every term and with deferred canonicalisation\n";
+	std::cout << "              (rationals only).\n";
+	std::cout << "          Default: loops\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -impl i\n";
+	std::cout << "          Implementation of the numbers used in the loops.\n";
+	std::cout << "          [1] gmp: lal::numeric (always GMP).\n";
+	std::cout << "          [2] inline: values are kept in machine words and only\n";
+	std::cout << "              use GMP when they do not fit in 64 bits.\n";
+	std::cout << "          [3] both: compare the two.\n";
+	std::cout << "          Default: gmp\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -threads P\n";
+	std::cout << "          Run the loops (with GMP) concurrently in 1, 2, 4, ..., P\n";
+	std::cout << "          threads, with and without a per-thread arena for GMP's\n";
+	std::cout << "          memory, and report the throughput.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -calls c\n";
+	std::cout << "          Number of top-level calls made by every thread when\n";
+	std::cout << "          using -threads. Every call runs each loop once.\n";
+	std::cout << "          Default: 10\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -bits b_1,b_2,...,b_k\n";
+	std::cout << "          Sizes in bits of the operands of the matrix.\n";
+	std::cout << "          Default: 64,256,4096,1048576\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -ops o_1,o_2,...,o_k\n";
+	std::cout << "          Operations of the matrix. Default: all of\n";
+	std::cout << "         ";
+	for (const std::string& op : m_allowed_ops) {
+	std::cout << ' ' << op;
+	}
+	std::cout << '\n';
+	std::cout << '\n';
+	std::cout << "    [?]   -min-time t\n";
+	std::cout << "          Minimum time, in milliseconds, spent measuring every\n";
+	std::cout << "          cell of the matrix.\n";
+	std::cout << "          Default: 100\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -threshold b\n";
+	std::cout << "          Growth in bits of the numerator or denominator since\n";
+	std::cout << "          the last canonicalisation past which a deferred sum\n";
+	std::cout << "          is canonicalised again.\n";
+	std::cout << "          Default: 4096\n";
+	std::cout << '\n';
+	// clang-format on
+}
+
+int numeric_pp::parse_params() noexcept
+{
+	// without parameters the profiler runs in its default mode
+	for (uint64_t i = 0; i < m_argc; ++i) {
+		const std::string param(m_argv[i]);
+
+		if (param == "--help" or param == "-h") {
+			print_usage();
+			return 1;
+		}
+		else if (param == "-mode") {
+			m_mode = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-impl") {
+			m_impl = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-bits") {
+			m_bits.clear();
+			std::stringstream ss(m_argv[i + 1]);
+			std::string b;
+			while (std::getline(ss, b, ',')) {
+				m_bits.push_back(static_cast<uint64_t>(atoll(b.c_str())));
+			}
+			++i;
+		}
+		else if (param == "-ops") {
+			m_ops.clear();
+			std::stringstream ss(m_argv[i + 1]);
+			std::string op;
+			while (std::getline(ss, op, ',')) {
+				m_ops.push_back(op);
+			}
+			++i;
+		}
+		else if (param == "-threads") {
+			m_threads = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			m_has_threads = true;
+			++i;
+		}
+		else if (param == "-calls") {
+			m_calls = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			++i;
+		}
+		else if (param == "-threshold") {
+			m_threshold = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			++i;
+		}
+		else if (param == "-min-time") {
+			m_min_time = atof(m_argv[i + 1]);
+			++i;
+		}
+		else {
+			std::cerr << "Error: unrecognised option\n";
+			std::cerr << "    " << param << '\n';
+			return 2;
+		}
+	}
+	return 0;
+}
+
+int numeric_pp::check_errors() const noexcept
+{
+	if (not m_allowed_modes.contains(m_mode)) {
+		std::cout << "Error: wrong mode '" << m_mode << "'.\n";
+		return 1;
+	}
+	if (not m_allowed_impls.contains(m_impl)) {
+		std::cout << "Error: wrong implementation '" << m_impl << "'.\n";
+		return 1;
+	}
+	if (m_impl != "gmp" and m_mode != "loops") {
+		std::cout << "Error: option -impl is only valid in mode 'loops'.\n";
+		return 1;
+	}
+	if (m_has_threads) {
+		if (m_mode != "loops" or m_impl != "gmp") {
+			std::cout << "Error: option -threads is only valid in mode\n";
+			std::cout << "    'loops' with implementation 'gmp'.\n";
+			return 1;
+		}
+		if (m_threads == 0) {
+			std::cout << "Error: the number of threads must be positive.\n";
+			return 1;
+		}
+	}
+	if (m_calls == 0) {
+		std::cout << "Error: the number of calls must be positive.\n";
+		return 1;
+	}
+	if (m_threshold == 0) {
+		std::cout << "Error: the threshold must be positive.\n";
+		return 1;
+	}
+	for (const uint64_t b : m_bits) {
+		if (b == 0) {
+			std::cout << "Error: the sizes of the operands must be positive.\n";
+			return 1;
+		}
+	}
+	for (const std::string& op : m_ops) {
+		if (not m_allowed_ops.contains(op)) {
+			std::cout << "Error: unknown operation '" << op << "'.\n";
+			return 1;
+		}
+	}
+	return 0;
+}
+
+} // namespace numeric
+} // namespace profiling
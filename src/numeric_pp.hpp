@@ -0,0 +1,153 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <set>
+
+namespace profiling {
+namespace numeric {
+
+class numeric_pp {
+public:
+
+	numeric_pp(uint64_t argc, char *argv[]) noexcept;
+	~numeric_pp() noexcept = default;
+
+	[[nodiscard]] const std::string& get_mode() const noexcept
+	{
+		return m_mode;
+	}
+	[[nodiscard]] const std::vector<uint64_t>& get_bits() const noexcept
+	{
+		return m_bits;
+	}
+	[[nodiscard]] const std::vector<std::string>& get_ops() const noexcept
+	{
+		return m_ops;
+	}
+	[[nodiscard]] double get_min_time() const noexcept
+	{
+		return m_min_time;
+	}
+	[[nodiscard]] const std::string& get_impl() const noexcept
+	{
+		return m_impl;
+	}
+	[[nodiscard]] uint64_t get_threshold() const noexcept
+	{
+		return m_threshold;
+	}
+	[[nodiscard]] bool has_threads() const noexcept
+	{
+		return m_has_threads;
+	}
+	[[nodiscard]] uint64_t get_threads() const noexcept
+	{
+		return m_threads;
+	}
+	[[nodiscard]] uint64_t get_calls() const noexcept
+	{
+		return m_calls;
+	}
+
+	void print_usage() const noexcept;
+
+	// returns 0 on success,
+	// returns 1 on help,
+	// returns 2 on error
+	[[nodiscard]] int parse_params() noexcept;
+
+	// returns 0 if there are no errors.
+	// returns 1 if there are errors.
+	[[nodiscard]] int check_errors() const noexcept;
+
+private:
+
+	// mode of the profiler
+	std::string m_mode = "loops";
+
+	// sizes, in bits, of the operands of the matrix
+	std::vector<uint64_t> m_bits = {64, 256, 4096, 1048576};
+
+	// operations of the matrix
+	std::vector<std::string> m_ops = {
+		"+",
+		"-",
+		"*",
+		"/",
+		"%",
+		"pow",
+		"compare",
+		"to_string",
+		"from_string",
+	};
+
+	// minimum time (in ms) spent measuring every cell of the matrix
+	double m_min_time = 100.0;
+
+	// implementation of the numbers in the loops
+	std::string m_impl = "gmp";
+
+	// growth (in bits) after which deferred sums are normalised again
+	uint64_t m_threshold = 4096;
+
+	// maximum number of threads of the multi-threaded loops
+	bool m_has_threads = false;
+	uint64_t m_threads = 1;
+
+	// number of top-level calls made by every thread
+	uint64_t m_calls = 10;
+
+	const std::set<std::string> m_allowed_modes =
+		std::set<std::string>({"loops", "matrix", "accumulate"});
+
+	const std::set<std::string> m_allowed_impls =
+		std::set<std::string>({"gmp", "inline", "both"});
+
+	const std::set<std::string> m_allowed_ops = std::set<std::string>(
+		{"+",
+		 "-",
+		 "*",
+		 "/",
+		 "%",
+		 "pow",
+		 "compare",
+		 "to_string",
+		 "from_string"}
+	);
+
+	uint64_t m_argc;
+	char **m_argv;
+};
+
+} // namespace numeric
+} // namespace profiling
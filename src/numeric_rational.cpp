@@ -25,264 +25,274 @@
  *
  ***********************************************************************/
 
-// C*+ includes
+// C++ includes
+#include <cstdlib>
 #include <iostream>
+#include <vector>
 
 // lal includes
 #include <lal/numeric/rational.hpp>
 #include <lal/numeric/output.hpp>
 
 // common includes
+#include "numeric_accumulator.hpp"
+#include "numeric_loops.hpp"
+#include "numeric_pp.hpp"
+#include "numeric_small.hpp"
 #include "time.hpp"
 
 namespace profiling {
+namespace numeric {
 
-void numeric_rational(
-	[[maybe_unused]] uint64_t argc, [[maybe_unused]] char *argv[]
-) noexcept
+namespace {
+
+// A top-level call of the multi-threaded loops: every loop once, with
+// integral operands.
+void call() noexcept
 {
+	lal::numeric::rational i = 1;
+	for (uint64_t f = 1; f < 5000; ++f) {
+		i = (i + f);
+	}
+	i = 1;
+	for (uint64_t f = 1; f < 5000; ++f) {
+		i = (i - f);
+	}
+	i = 1;
+	for (uint64_t f = 1; f < 5000; ++f) {
+		i = (i * f);
+	}
+	for (uint64_t f = 1; f < 5000; ++f) {
+		i = (i / f);
+	}
+}
 
+template <class integer_t, class rational_t>
+void loops(loop_times& times) noexcept
+{
 	profiling::time_point begin, end;
 	double total;
 
 	// additions
 	{
-		std::cout << "------------------------\n";
+		times.emplace_back("", 0.0);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
+			rational_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i = (i + f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Additions (rational + integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Additions (rational + integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i = (i + f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Additions (rational + integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Additions (rational + integer)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::rational f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (rational_t f = 1; f < 5000; f += 1) {
 				i = (i + f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Additions (rational + rational): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Additions (rational + rational)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
+			rational_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i += f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Additions (+= integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Additions (+= integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i += f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Additions (+= integer): " << profiling::time_to_str(total)
-				  << '\n';
+		times.emplace_back("Additions (+= integer)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::rational f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (rational_t f = 1; f < 5000; f += 1) {
 				i += f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Additions (+= rational): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Additions (+= rational)", total);
 	}
 
 	// substractions
 	{
-		std::cout << "------------------------\n";
+		times.emplace_back("", 0.0);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
+			rational_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i = (i - f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Subtractions (rational - integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Subtractions (rational - integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i = (i - f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Subtractions (rational - integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Subtractions (rational - integer)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::rational f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (rational_t f = 1; f < 5000; f += 1) {
 				i = (i - f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Subtractions (rational - rational): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Subtractions (rational - rational)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
+			rational_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i -= f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Subtractions (-= integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Subtractions (-= integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i -= f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Subtractions (-= integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Subtractions (-= integer)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::rational f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (rational_t f = 1; f < 5000; f += 1) {
 				i -= f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Subtractions (-= rational): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Subtractions (-= rational)", total);
 	}
 
 	// multiplications
 	{
-		std::cout << "------------------------\n";
+		times.emplace_back("", 0.0);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
+			rational_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i = (i * f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Multiplications (rational * integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Multiplications (rational * integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i = (i * f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Multiplications (rational * integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Multiplications (rational * integer)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::rational f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (rational_t f = 1; f < 5000; f += 1) {
 				i = (i * f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Multiplications (rational * rational): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Multiplications (rational * rational)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
+			rational_t i = 1;
 			for (uint64_t f = 1; f < 5000; ++f) {
 				i *= f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Multiplications (*= integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Multiplications (*= integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i *= f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Multiplications (*= integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Multiplications (*= integer)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::rational f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (rational_t f = 1; f < 5000; f += 1) {
 				i *= f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Multiplications (*= rational): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Multiplications (*= rational)", total);
 	}
 
 	// divisions
 	{
-		std::cout << "------------------------\n";
+		times.emplace_back("", 0.0);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = std::string(
+			rational_t i = std::string(
 				"99999999999999999999999999999999999999999999999999999999999999"
 				"99999999999999999999999999999999999999999999999999999999999999"
 				"99999999999999999999999999999999999999999999999999999999999999"
@@ -321,36 +331,33 @@ void numeric_rational(
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Divisions (rational / integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Divisions (rational / integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i = (i / f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Divisions (rational / integer): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Divisions (rational / integer)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::rational f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (rational_t f = 1; f < 5000; f += 1) {
 				i = (i / f);
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Divisions (rational / rational): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Divisions (rational / rational)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = std::string(
+			rational_t i = std::string(
 				"99999999999999999999999999999999999999999999999999999999999999"
 				"99999999999999999999999999999999999999999999999999999999999999"
 				"99999999999999999999999999999999999999999999999999999999999999"
@@ -389,32 +396,213 @@ void numeric_rational(
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Divisions (/= integral): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Divisions (/= integral)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::integer f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (integer_t f = 1; f < 5000; f += 1) {
 				i /= f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Divisions (/= integer): " << profiling::time_to_str(total)
-				  << '\n';
+		times.emplace_back("Divisions (/= integer)", total);
 
 		begin = profiling::now();
 		for (int k = 0; k < 1000; ++k) {
-			lal::numeric::rational i = 1;
-			for (lal::numeric::rational f = 1; f < 5000; f += 1) {
+			rational_t i = 1;
+			for (rational_t f = 1; f < 5000; f += 1) {
 				i /= f;
 			}
 		}
 		end = profiling::now();
 		total = profiling::elapsed_time(begin, end);
-		std::cout << "Divisions (/= rational): "
-				  << profiling::time_to_str(total) << '\n';
+		times.emplace_back("Divisions (/= rational)", total);
+	}
+}
+
+// Sums the terms n_j/d_j, 'reps' times, canonicalising after every term
+// (lal::numeric::rational) and with deferred canonicalisation. Every sum of
+// the deferred accumulator ends with its canonicalisation, which is timed.
+void accumulation_loop(
+	const std::string& name,
+	const std::vector<std::pair<int64_t, uint64_t>>& terms,
+	const uint64_t reps,
+	const uint64_t threshold
+) noexcept
+{
+	profiling::time_point begin, end;
+
+	std::vector<lal::numeric::rational> rational_terms;
+	rational_terms.reserve(terms.size());
+	for (const auto& [n, d] : terms) {
+		rational_terms.emplace_back(n, d);
+	}
+
+	std::cout << "------------------------\n";
+	std::cout << name << " (" << reps << " repetitions)\n";
+
+	lal::numeric::rational eager;
+
+	begin = profiling::now();
+	for (uint64_t k = 0; k < reps; ++k) {
+		eager = 1;
+		for (const lal::numeric::rational& f : rational_terms) {
+			eager = (eager + f);
+		}
+	}
+	end = profiling::now();
+	const double total_plus = profiling::elapsed_time(begin, end);
+	std::cout << "    Eager (rational + rational): "
+			  << profiling::time_to_str(total_plus) << '\n';
+
+	begin = profiling::now();
+	for (uint64_t k = 0; k < reps; ++k) {
+		eager = 1;
+		for (const lal::numeric::rational& f : rational_terms) {
+			eager += f;
+		}
+	}
+	end = profiling::now();
+	const double total_inc = profiling::elapsed_time(begin, end);
+	std::cout << "    Eager (+= rational):         "
+			  << profiling::time_to_str(total_inc) << '\n';
+
+	// the same word-sized terms that the deferred accumulator is given
+	begin = profiling::now();
+	for (uint64_t k = 0; k < reps; ++k) {
+		eager = 1;
+		for (const auto& [n, d] : terms) {
+			eager += lal::numeric::rational(n, d);
+		}
+	}
+	end = profiling::now();
+	const double total_word = profiling::elapsed_time(begin, end);
+	std::cout << "    Eager (+= n/d):              "
+			  << profiling::time_to_str(total_word) << '\n';
+
+	rational_accumulator deferred(threshold);
+
+	mpq_t value;
+	mpq_init(value);
+
+	begin = profiling::now();
+	for (uint64_t k = 0; k < reps; ++k) {
+		deferred.set(1, 1);
+		for (const auto& [n, d] : terms) {
+			deferred.add(n, d);
+		}
+		deferred.get(value);
+	}
+	end = profiling::now();
+	const double total_deferred = profiling::elapsed_time(begin, end);
+	std::cout << "    Deferred (+=, threshold " << threshold
+			  << " bits): " << profiling::time_to_str(total_deferred) << '\n';
+	std::cout << "    Speedup over (+= rational): "
+			  << total_inc / total_deferred << '\n';
+	std::cout << "    Speedup over (+= n/d):      "
+			  << total_word / total_deferred << '\n';
+
+	const uint64_t num_bits = mpz_sizeinbase(mpq_numref(value), 2);
+	const uint64_t den_bits = mpz_sizeinbase(mpq_denref(value), 2);
+	std::cout << "    Normalisations per sum: "
+			  << deferred.get_num_normalizations() << '\n';
+	std::cout << "    Numerator bits:   canonical " << num_bits
+			  << ", largest deferred " << deferred.get_max_numerator_bits()
+			  << '\n';
+	std::cout << "    Denominator bits: canonical " << den_bits
+			  << ", largest deferred " << deferred.get_max_denominator_bits()
+			  << '\n';
+
+	std::string str(
+		mpz_sizeinbase(mpq_numref(value), 10) +
+			mpz_sizeinbase(mpq_denref(value), 10) + 3,
+		'\0'
+	);
+	mpq_get_str(str.data(), 10, value);
+	str.resize(str.find('\0'));
+	mpq_clear(value);
+
+	if (eager != lal::numeric::rational(str)) {
+		std::cerr << "ERROR! The deferred sum differs from the eager sum.\n";
+		std::cerr << "    Eager:    " << eager << '\n';
+		std::cerr << "    Deferred: " << str << '\n';
+		std::abort();
+	}
+}
+
+void accumulate(const numeric_pp& parser) noexcept
+{
+	const uint64_t threshold = parser.get_threshold();
+
+	std::vector<std::pair<int64_t, uint64_t>> terms;
+
+	// the terms of the loops: f = 1, ..., 4999
+	for (int64_t f = 1; f < 5000; ++f) {
+		terms.emplace_back(f, 1);
+	}
+	accumulation_loop("Integer terms f = 1, ..., 4999", terms, 1000, threshold);
+
+	// harmonic sums, whose denominators grow with every term
+	terms.clear();
+	for (uint64_t f = 1; f < 5000; ++f) {
+		terms.emplace_back(1, f);
+	}
+	accumulation_loop(
+		"Harmonic terms 1/f, f = 1, ..., 4999", terms, 10, threshold
+	);
+}
+
+} // namespace
+
+} // namespace numeric
+
+void numeric_rational(uint64_t argc, char *argv[]) noexcept
+{
+	numeric::numeric_pp parser(argc, argv);
+	{
+		if (parser.parse_params() > 0) {
+			return;
+		}
+		if (parser.check_errors() > 0) {
+			return;
+		}
+		if (parser.get_mode() == "matrix") {
+			std::cout << "Error: mode '" << parser.get_mode()
+					  << "' is only available for numeric_integer.\n";
+			return;
+		}
+	}
+
+	if (parser.get_mode() == "accumulate") {
+		numeric::accumulate(parser);
+		return;
+	}
+	if (parser.has_threads()) {
+		numeric::print_thread_scaling(
+			parser.get_threads(), parser.get_calls(), numeric::call
+		);
+		return;
+	}
+
+	const std::string& impl = parser.get_impl();
+	numeric::loop_times gmp, small;
+	if (impl != "inline") {
+		numeric::loops<lal::numeric::integer, lal::numeric::rational>(gmp);
+	}
+	if (impl != "gmp") {
+		numeric::loops<numeric::small_integer, numeric::small_rational>(small);
+	}
+
+	if (impl == "gmp") {
+		numeric::print_loop_times(gmp);
+	}
+	else if (impl == "inline") {
+		numeric::print_loop_times(small);
+	}
+	else {
+		numeric::print_loop_times(gmp, small);
 	}
 }
 
@@ -0,0 +1,461 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "numeric_small.hpp"
+
+// C++ includes
+#include <charconv>
+#include <numeric>
+
+namespace profiling {
+namespace numeric {
+
+namespace {
+
+// Sets 'z' to a read-only mpz_t with value 'v', whose only limb is stored in
+// 'limb', so that no memory is allocated.
+mpz_srcptr set_view(mpz_ptr z, mp_limb_t& limb, const int64_t v) noexcept
+{
+	limb = (v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v));
+	const mp_size_t size = (v == 0 ? 0 : (v < 0 ? -1 : 1));
+	return mpz_roinit_n(z, &limb, size);
+}
+
+// Read-only view of a small_integer as an mpz_t.
+class mpz_view {
+public:
+
+	mpz_view(const small_integer& i) noexcept
+	{
+		m_ptr = i.is_small() ? set_view(m_z, m_limb, i.get_small())
+							 : i.get_big();
+	}
+	mpz_view(const mpz_view&) = delete;
+
+	[[nodiscard]] mpz_srcptr get() const noexcept
+	{
+		return m_ptr;
+	}
+
+private:
+
+	mp_limb_t m_limb;
+	mpz_t m_z;
+	mpz_srcptr m_ptr;
+};
+
+// Read-only view of a small_rational as an mpq_t.
+class mpq_view {
+public:
+
+	mpq_view(const small_rational& r) noexcept
+	{
+		if (r.is_small()) {
+			set_view(mpq_numref(m_q), m_num, r.get_small_numerator());
+			set_view(mpq_denref(m_q), m_den, r.get_small_denominator());
+			m_ptr = m_q;
+		}
+		else {
+			m_ptr = r.get_big();
+		}
+	}
+	mpq_view(const mpq_view&) = delete;
+
+	[[nodiscard]] mpq_srcptr get() const noexcept
+	{
+		return m_ptr;
+	}
+
+private:
+
+	mp_limb_t m_num;
+	mp_limb_t m_den;
+	mpq_t m_q;
+	mpq_srcptr m_ptr;
+};
+
+} // namespace
+
+/* small_integer */
+
+small_integer::small_integer(const std::string& s) noexcept
+{
+	const char * const end = s.data() + s.size();
+	const auto [ptr, ec] = std::from_chars(s.data(), end, m_small);
+	if (ec != std::errc() or ptr != end) {
+		make_big();
+		mpz_set_str(m_big, s.c_str(), 10);
+		demote();
+	}
+}
+
+small_integer::small_integer(const small_integer& i) noexcept
+{
+	*this = i;
+}
+
+small_integer::small_integer(small_integer&& i) noexcept
+{
+	*this = std::move(i);
+}
+
+small_integer::~small_integer() noexcept
+{
+	if (m_has_big) {
+		mpz_clear(m_big);
+	}
+}
+
+small_integer& small_integer::operator=(const small_integer& i) noexcept
+{
+	if (i.m_is_small) {
+		set_small(i.m_small);
+	}
+	else if (this != &i) {
+		make_big();
+		mpz_set(m_big, i.m_big);
+	}
+	return *this;
+}
+
+small_integer& small_integer::operator=(small_integer&& i) noexcept
+{
+	if (i.m_is_small) {
+		set_small(i.m_small);
+	}
+	else if (this != &i) {
+		if (m_has_big) {
+			mpz_swap(m_big, i.m_big);
+		}
+		else {
+			*m_big = *i.m_big;
+			m_has_big = true;
+			i.m_has_big = false;
+			i.set_small(0);
+		}
+		m_is_small = false;
+	}
+	return *this;
+}
+
+std::string small_integer::to_string() const noexcept
+{
+	if (m_is_small) {
+		return std::to_string(m_small);
+	}
+	std::string s(mpz_sizeinbase(m_big, 10) + 2, '\0');
+	mpz_get_str(s.data(), 10, m_big);
+	s.resize(s.find('\0'));
+	return s;
+}
+
+void small_integer::set_big_unsigned(const uint64_t i) noexcept
+{
+	make_big();
+	mpz_set_ui(m_big, i);
+}
+
+void small_integer::make_big() noexcept
+{
+	if (not m_has_big) {
+		mpz_init(m_big);
+		m_has_big = true;
+	}
+	m_is_small = false;
+}
+
+void small_integer::demote() noexcept
+{
+	if (mpz_fits_slong_p(m_big)) {
+		set_small(mpz_get_si(m_big));
+	}
+}
+
+void small_integer::add_big(
+	const small_integer& a, const small_integer& b
+) noexcept
+{
+	const mpz_view va(a), vb(b);
+	make_big();
+	mpz_add(m_big, va.get(), vb.get());
+	demote();
+}
+
+void small_integer::sub_big(
+	const small_integer& a, const small_integer& b
+) noexcept
+{
+	const mpz_view va(a), vb(b);
+	make_big();
+	mpz_sub(m_big, va.get(), vb.get());
+	demote();
+}
+
+void small_integer::mul_big(
+	const small_integer& a, const small_integer& b
+) noexcept
+{
+	const mpz_view va(a), vb(b);
+	make_big();
+	mpz_mul(m_big, va.get(), vb.get());
+	demote();
+}
+
+void small_integer::div_big(
+	const small_integer& a, const small_integer& b
+) noexcept
+{
+	const mpz_view va(a), vb(b);
+	make_big();
+	mpz_fdiv_q(m_big, va.get(), vb.get());
+	demote();
+}
+
+int small_integer::compare_big(const small_integer& i) const noexcept
+{
+	const mpz_view va(*this), vb(i);
+	return mpz_cmp(va.get(), vb.get());
+}
+
+/* small_rational */
+
+small_rational::small_rational(const small_integer& i) noexcept
+{
+	if (i.is_small()) {
+		m_num = i.get_small();
+	}
+	else {
+		make_big();
+		mpq_set_z(m_big, i.get_big());
+	}
+}
+
+small_rational::small_rational(const std::string& s) noexcept
+{
+	make_big();
+	mpq_set_str(m_big, s.c_str(), 10);
+	mpq_canonicalize(m_big);
+	demote();
+}
+
+small_rational::small_rational(const small_rational& r) noexcept
+{
+	*this = r;
+}
+
+small_rational::small_rational(small_rational&& r) noexcept
+{
+	*this = std::move(r);
+}
+
+small_rational::~small_rational() noexcept
+{
+	if (m_has_big) {
+		mpq_clear(m_big);
+	}
+}
+
+small_rational& small_rational::operator=(const small_rational& r) noexcept
+{
+	if (r.m_is_small) {
+		set_small(r.m_num, r.m_den);
+	}
+	else if (this != &r) {
+		make_big();
+		mpq_set(m_big, r.m_big);
+	}
+	return *this;
+}
+
+small_rational& small_rational::operator=(small_rational&& r) noexcept
+{
+	if (r.m_is_small) {
+		set_small(r.m_num, r.m_den);
+	}
+	else if (this != &r) {
+		if (m_has_big) {
+			mpq_swap(m_big, r.m_big);
+		}
+		else {
+			*m_big = *r.m_big;
+			m_has_big = true;
+			r.m_has_big = false;
+			r.set_small(0, 1);
+		}
+		m_is_small = false;
+	}
+	return *this;
+}
+
+int small_rational::compare(const small_rational& r) const noexcept
+{
+	if (m_is_small and r.m_is_small) [[likely]] {
+		if (m_den == r.m_den) {
+			return (m_num < r.m_num ? -1 : (m_num > r.m_num ? 1 : 0));
+		}
+		int64_t x, y;
+		if (not __builtin_mul_overflow(m_num, r.m_den, &x) and
+			not __builtin_mul_overflow(r.m_num, m_den, &y)) {
+			return (x < y ? -1 : (x > y ? 1 : 0));
+		}
+	}
+	const mpq_view va(*this), vb(r);
+	return mpq_cmp(va.get(), vb.get());
+}
+
+std::string small_rational::to_string() const noexcept
+{
+	if (m_is_small) {
+		return m_den == 1 ? std::to_string(m_num)
+						  : std::to_string(m_num) + "/" + std::to_string(m_den);
+	}
+	std::string s(
+		mpz_sizeinbase(mpq_numref(m_big), 10) +
+			mpz_sizeinbase(mpq_denref(m_big), 10) + 3,
+		'\0'
+	);
+	mpq_get_str(s.data(), 10, m_big);
+	s.resize(s.find('\0'));
+	return s;
+}
+
+bool small_rational::add_small(
+	const int64_t an, const int64_t ad, const int64_t bn, const int64_t bd
+) noexcept
+{
+	// Knuth, TAOCP vol. 2, 4.5.1: both operands are in canonical form, so
+	// only the gcd of the denominators needs to be removed.
+	const int64_t g = std::gcd(ad, bd);
+	int64_t x, y, t;
+	if (__builtin_mul_overflow(an, bd / g, &x) or
+		__builtin_mul_overflow(bn, ad / g, &y) or
+		__builtin_add_overflow(x, y, &t)) {
+		return false;
+	}
+	if (t == 0) {
+		set_small(0, 1);
+		return true;
+	}
+	if (t == std::numeric_limits<int64_t>::min()) {
+		return false;
+	}
+
+	const int64_t g2 = (g == 1 ? 1 : std::gcd(t, g));
+	int64_t den;
+	if (__builtin_mul_overflow(ad / g, bd / g2, &den)) {
+		return false;
+	}
+	set_small(t / g2, den);
+	return true;
+}
+
+bool small_rational::mul_small(
+	const int64_t an, const int64_t ad, const int64_t bn, const int64_t bd
+) noexcept
+{
+	if (an == 0 or bn == 0) {
+		set_small(0, 1);
+		return true;
+	}
+	if (an == std::numeric_limits<int64_t>::min() or
+		bn == std::numeric_limits<int64_t>::min()) {
+		return false;
+	}
+
+	// cross-cancel so that the result is in canonical form
+	const int64_t g1 = std::gcd(an, bd);
+	const int64_t g2 = std::gcd(bn, ad);
+	int64_t num, den;
+	if (__builtin_mul_overflow(an / g1, bn / g2, &num) or
+		__builtin_mul_overflow(ad / g2, bd / g1, &den)) {
+		return false;
+	}
+	set_small(num, den);
+	return true;
+}
+
+void small_rational::make_big() noexcept
+{
+	if (not m_has_big) {
+		mpq_init(m_big);
+		m_has_big = true;
+	}
+	m_is_small = false;
+}
+
+void small_rational::demote() noexcept
+{
+	if (mpz_fits_slong_p(mpq_numref(m_big)) and
+		mpz_fits_slong_p(mpq_denref(m_big))) {
+		set_small(
+			mpz_get_si(mpq_numref(m_big)), mpz_get_si(mpq_denref(m_big))
+		);
+	}
+}
+
+void small_rational::add_big(
+	const small_rational& a, const small_rational& b
+) noexcept
+{
+	const mpq_view va(a), vb(b);
+	make_big();
+	mpq_add(m_big, va.get(), vb.get());
+	demote();
+}
+
+void small_rational::sub_big(
+	const small_rational& a, const small_rational& b
+) noexcept
+{
+	const mpq_view va(a), vb(b);
+	make_big();
+	mpq_sub(m_big, va.get(), vb.get());
+	demote();
+}
+
+void small_rational::mul_big(
+	const small_rational& a, const small_rational& b
+) noexcept
+{
+	const mpq_view va(a), vb(b);
+	make_big();
+	mpq_mul(m_big, va.get(), vb.get());
+	demote();
+}
+
+void small_rational::div_big(
+	const small_rational& a, const small_rational& b
+) noexcept
+{
+	const mpq_view va(a), vb(b);
+	make_big();
+	mpq_div(m_big, va.get(), vb.get());
+	demote();
+}
+
+} // namespace numeric
+} // namespace profiling
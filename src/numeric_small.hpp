@@ -0,0 +1,490 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+// gmp includes
+#include <gmp.h>
+
+namespace profiling {
+namespace numeric {
+
+static_assert(sizeof(mp_limb_t) == sizeof(int64_t));
+static_assert(sizeof(long) == sizeof(int64_t));
+
+/*
+ * Integers and rationals with a small-value fast path.
+ *
+ * Values are kept inline, in machine words, while they fit in 64 bits. An
+ * operation whose result overflows (detected with the compiler's checked
+ * arithmetic builtins) is redone with GMP and the result is kept in an mpz_t
+ * (or mpq_t). Results that fit in 64 bits again are moved back inline. The
+ * memory of GMP's object, once allocated, is kept for later overflows.
+ *
+ * Division of integers rounds towards minus infinity, as in
+ * lal::numeric::integer. Only the operations used by the numeric profilers
+ * are implemented.
+ */
+
+class small_integer {
+public:
+
+	small_integer() noexcept = default;
+	template <std::integral T>
+	small_integer(const T i) noexcept
+	{
+		if constexpr (std::is_signed_v<T>) {
+			m_small = i;
+		}
+		else if (i <= static_cast<uint64_t>(
+					 std::numeric_limits<int64_t>::max()
+				 )) {
+			m_small = static_cast<int64_t>(i);
+		}
+		else {
+			set_big_unsigned(i);
+		}
+	}
+	small_integer(const std::string& s) noexcept;
+	small_integer(const small_integer& i) noexcept;
+	small_integer(small_integer&& i) noexcept;
+	~small_integer() noexcept;
+
+	small_integer& operator=(const small_integer& i) noexcept;
+	small_integer& operator=(small_integer&& i) noexcept;
+
+	/* SETTERS */
+
+	void add(const small_integer& a, const small_integer& b) noexcept
+	{
+		int64_t r;
+		if (a.m_is_small and b.m_is_small and
+			not __builtin_add_overflow(a.m_small, b.m_small, &r)) [[likely]] {
+			set_small(r);
+			return;
+		}
+		add_big(a, b);
+	}
+	void sub(const small_integer& a, const small_integer& b) noexcept
+	{
+		int64_t r;
+		if (a.m_is_small and b.m_is_small and
+			not __builtin_sub_overflow(a.m_small, b.m_small, &r)) [[likely]] {
+			set_small(r);
+			return;
+		}
+		sub_big(a, b);
+	}
+	void mul(const small_integer& a, const small_integer& b) noexcept
+	{
+		int64_t r;
+		if (a.m_is_small and b.m_is_small and
+			not __builtin_mul_overflow(a.m_small, b.m_small, &r)) [[likely]] {
+			set_small(r);
+			return;
+		}
+		mul_big(a, b);
+	}
+	void div(const small_integer& a, const small_integer& b) noexcept
+	{
+		// the only overflow is min/-1
+		if (a.m_is_small and b.m_is_small and
+			not (a.m_small == std::numeric_limits<int64_t>::min() and
+				 b.m_small == -1)) [[likely]] {
+			int64_t q = a.m_small / b.m_small;
+			if (a.m_small % b.m_small != 0 and
+				((a.m_small < 0) != (b.m_small < 0))) {
+				--q;
+			}
+			set_small(q);
+			return;
+		}
+		div_big(a, b);
+	}
+
+	/* OPERATORS */
+
+	template <typename T>
+	small_integer& operator+=(const T& i) noexcept
+	{
+		add(*this, as_integer(i));
+		return *this;
+	}
+	template <typename T>
+	small_integer& operator-=(const T& i) noexcept
+	{
+		sub(*this, as_integer(i));
+		return *this;
+	}
+	template <typename T>
+	small_integer& operator*=(const T& i) noexcept
+	{
+		mul(*this, as_integer(i));
+		return *this;
+	}
+	template <typename T>
+	small_integer& operator/=(const T& i) noexcept
+	{
+		div(*this, as_integer(i));
+		return *this;
+	}
+
+	template <typename T>
+	[[nodiscard]] small_integer operator+(const T& i) const noexcept
+	{
+		small_integer r;
+		r.add(*this, as_integer(i));
+		return r;
+	}
+	template <typename T>
+	[[nodiscard]] small_integer operator-(const T& i) const noexcept
+	{
+		small_integer r;
+		r.sub(*this, as_integer(i));
+		return r;
+	}
+	template <typename T>
+	[[nodiscard]] small_integer operator*(const T& i) const noexcept
+	{
+		small_integer r;
+		r.mul(*this, as_integer(i));
+		return r;
+	}
+	template <typename T>
+	[[nodiscard]] small_integer operator/(const T& i) const noexcept
+	{
+		small_integer r;
+		r.div(*this, as_integer(i));
+		return r;
+	}
+
+	template <typename T>
+	[[nodiscard]] bool operator==(const T& i) const noexcept
+	{
+		return compare(as_integer(i)) == 0;
+	}
+	template <typename T>
+	[[nodiscard]] bool operator<(const T& i) const noexcept
+	{
+		return compare(as_integer(i)) < 0;
+	}
+	template <typename T>
+	[[nodiscard]] bool operator>(const T& i) const noexcept
+	{
+		return compare(as_integer(i)) > 0;
+	}
+
+	/* GETTERS */
+
+	// Returns a negative value, zero or a positive value if this integer is
+	// less than, equal to or greater than 'i'.
+	[[nodiscard]] int compare(const small_integer& i) const noexcept
+	{
+		if (m_is_small and i.m_is_small) [[likely]] {
+			return (m_small < i.m_small ? -1 : (m_small > i.m_small ? 1 : 0));
+		}
+		return compare_big(i);
+	}
+
+	[[nodiscard]] bool is_small() const noexcept
+	{
+		return m_is_small;
+	}
+	// Value of the integer. Only valid when is_small().
+	[[nodiscard]] int64_t get_small() const noexcept
+	{
+		return m_small;
+	}
+	// Value of the integer. Only valid when not is_small().
+	[[nodiscard]] mpz_srcptr get_big() const noexcept
+	{
+		return m_big;
+	}
+
+	[[nodiscard]] std::string to_string() const noexcept;
+
+private:
+
+	template <typename T>
+	[[nodiscard]] static const small_integer& as_integer(const T& i) noexcept
+		requires std::same_as<T, small_integer>
+	{
+		return i;
+	}
+	template <std::integral T>
+	[[nodiscard]] static small_integer as_integer(const T i) noexcept
+	{
+		return small_integer(i);
+	}
+
+	void set_small(const int64_t i) noexcept
+	{
+		m_small = i;
+		m_is_small = true;
+	}
+	void set_big_unsigned(const uint64_t i) noexcept;
+
+	// Initialises m_big if needed and marks the value as not small.
+	void make_big() noexcept;
+	// Moves the value back inline if it fits in 64 bits.
+	void demote() noexcept;
+
+	void add_big(const small_integer& a, const small_integer& b) noexcept;
+	void sub_big(const small_integer& a, const small_integer& b) noexcept;
+	void mul_big(const small_integer& a, const small_integer& b) noexcept;
+	void div_big(const small_integer& a, const small_integer& b) noexcept;
+	[[nodiscard]] int compare_big(const small_integer& i) const noexcept;
+
+	// value of the integer when it fits in 64 bits
+	int64_t m_small = 0;
+	// value of the integer when it does not fit in 64 bits
+	mpz_t m_big;
+	// is the value in m_small?
+	bool m_is_small = true;
+	// has m_big been initialised?
+	bool m_has_big = false;
+};
+
+class small_rational {
+public:
+
+	small_rational() noexcept = default;
+	template <std::integral T>
+	small_rational(const T i) noexcept
+		: small_rational(small_integer(i))
+	{ }
+	small_rational(const small_integer& i) noexcept;
+	small_rational(const std::string& s) noexcept;
+	small_rational(const small_rational& r) noexcept;
+	small_rational(small_rational&& r) noexcept;
+	~small_rational() noexcept;
+
+	small_rational& operator=(const small_rational& r) noexcept;
+	small_rational& operator=(small_rational&& r) noexcept;
+
+	/* SETTERS */
+
+	void add(const small_rational& a, const small_rational& b) noexcept
+	{
+		if (a.m_is_small and b.m_is_small and
+			add_small(a.m_num, a.m_den, b.m_num, b.m_den)) [[likely]] {
+			return;
+		}
+		add_big(a, b);
+	}
+	void sub(const small_rational& a, const small_rational& b) noexcept
+	{
+		if (a.m_is_small and b.m_is_small and
+			b.m_num != std::numeric_limits<int64_t>::min() and
+			add_small(a.m_num, a.m_den, -b.m_num, b.m_den)) [[likely]] {
+			return;
+		}
+		sub_big(a, b);
+	}
+	void mul(const small_rational& a, const small_rational& b) noexcept
+	{
+		if (a.m_is_small and b.m_is_small and
+			mul_small(a.m_num, a.m_den, b.m_num, b.m_den)) [[likely]] {
+			return;
+		}
+		mul_big(a, b);
+	}
+	void div(const small_rational& a, const small_rational& b) noexcept
+	{
+		// multiply by the inverse of b, whose numerator has b's sign
+		if (a.m_is_small and b.m_is_small and b.m_num != 0 and
+			b.m_num != std::numeric_limits<int64_t>::min() and
+			mul_small(
+				a.m_num,
+				a.m_den,
+				b.m_num < 0 ? -b.m_den : b.m_den,
+				b.m_num < 0 ? -b.m_num : b.m_num
+			)) [[likely]] {
+			return;
+		}
+		div_big(a, b);
+	}
+
+	/* OPERATORS */
+
+	template <typename T>
+	small_rational& operator+=(const T& r) noexcept
+	{
+		add(*this, as_rational(r));
+		return *this;
+	}
+	template <typename T>
+	small_rational& operator-=(const T& r) noexcept
+	{
+		sub(*this, as_rational(r));
+		return *this;
+	}
+	template <typename T>
+	small_rational& operator*=(const T& r) noexcept
+	{
+		mul(*this, as_rational(r));
+		return *this;
+	}
+	template <typename T>
+	small_rational& operator/=(const T& r) noexcept
+	{
+		div(*this, as_rational(r));
+		return *this;
+	}
+
+	template <typename T>
+	[[nodiscard]] small_rational operator+(const T& r) const noexcept
+	{
+		small_rational res;
+		res.add(*this, as_rational(r));
+		return res;
+	}
+	template <typename T>
+	[[nodiscard]] small_rational operator-(const T& r) const noexcept
+	{
+		small_rational res;
+		res.sub(*this, as_rational(r));
+		return res;
+	}
+	template <typename T>
+	[[nodiscard]] small_rational operator*(const T& r) const noexcept
+	{
+		small_rational res;
+		res.mul(*this, as_rational(r));
+		return res;
+	}
+	template <typename T>
+	[[nodiscard]] small_rational operator/(const T& r) const noexcept
+	{
+		small_rational res;
+		res.div(*this, as_rational(r));
+		return res;
+	}
+
+	template <typename T>
+	[[nodiscard]] bool operator==(const T& r) const noexcept
+	{
+		return compare(as_rational(r)) == 0;
+	}
+	template <typename T>
+	[[nodiscard]] bool operator<(const T& r) const noexcept
+	{
+		return compare(as_rational(r)) < 0;
+	}
+	template <typename T>
+	[[nodiscard]] bool operator>(const T& r) const noexcept
+	{
+		return compare(as_rational(r)) > 0;
+	}
+
+	/* GETTERS */
+
+	// Returns a negative value, zero or a positive value if this rational is
+	// less than, equal to or greater than 'r'.
+	[[nodiscard]] int compare(const small_rational& r) const noexcept;
+
+	[[nodiscard]] bool is_small() const noexcept
+	{
+		return m_is_small;
+	}
+	// Numerator and denominator. Only valid when is_small().
+	[[nodiscard]] int64_t get_small_numerator() const noexcept
+	{
+		return m_num;
+	}
+	[[nodiscard]] int64_t get_small_denominator() const noexcept
+	{
+		return m_den;
+	}
+	// Value of the rational. Only valid when not is_small().
+	[[nodiscard]] mpq_srcptr get_big() const noexcept
+	{
+		return m_big;
+	}
+
+	[[nodiscard]] std::string to_string() const noexcept;
+
+private:
+
+	template <typename T>
+	[[nodiscard]] static const small_rational& as_rational(const T& r) noexcept
+		requires std::same_as<T, small_rational>
+	{
+		return r;
+	}
+	template <typename T>
+	[[nodiscard]] static small_rational as_rational(const T& i) noexcept
+		requires(not std::same_as<T, small_rational>)
+	{
+		return small_rational(i);
+	}
+
+	void set_small(const int64_t num, const int64_t den) noexcept
+	{
+		m_num = num;
+		m_den = den;
+		m_is_small = true;
+	}
+
+	// Sets this rational to an/ad + bn/bd. Returns false on overflow.
+	[[nodiscard]] bool add_small(
+		const int64_t an, const int64_t ad, const int64_t bn, const int64_t bd
+	) noexcept;
+	// Sets this rational to (an/ad)*(bn/bd). Returns false on overflow.
+	[[nodiscard]] bool mul_small(
+		const int64_t an, const int64_t ad, const int64_t bn, const int64_t bd
+	) noexcept;
+
+	// Initialises m_big if needed and marks the value as not small.
+	void make_big() noexcept;
+	// Moves the value back inline if it fits in 64 bits.
+	void demote() noexcept;
+
+	void add_big(const small_rational& a, const small_rational& b) noexcept;
+	void sub_big(const small_rational& a, const small_rational& b) noexcept;
+	void mul_big(const small_rational& a, const small_rational& b) noexcept;
+	void div_big(const small_rational& a, const small_rational& b) noexcept;
+
+	// numerator and (positive) denominator, coprime, when they fit in 64 bits
+	int64_t m_num = 0;
+	int64_t m_den = 1;
+	// value of the rational when it does not fit in 64 bits
+	mpq_t m_big;
+	// is the value in m_num and m_den?
+	bool m_is_small = true;
+	// has m_big been initialised?
+	bool m_has_big = false;
+};
+
+} // namespace numeric
+} // namespace profiling
@@ -0,0 +1,123 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "parallel_construction.hpp"
+
+// C++ includes
+#include <algorithm>
+
+// omp includes
+#include <omp.h>
+
+namespace profiling {
+namespace graphs {
+
+void build_adjacency_lists(
+	const uint64_t n,
+	const lal::edge_list& edges,
+	const bool directed,
+	const int num_threads,
+	std::vector<lal::neighbourhood>& out,
+	std::vector<lal::neighbourhood>& in
+) noexcept
+{
+	const std::size_t m = edges.size();
+	const std::size_t P = static_cast<std::size_t>(num_threads);
+
+	out.clear();
+	out.resize(n);
+	in.clear();
+	if (directed) {
+		in.resize(n);
+	}
+
+	// position of the next neighbour of every vertex written by every thread
+	std::vector<std::size_t> count_out(P * n);
+	std::vector<std::size_t> count_in(directed ? P * n : 0);
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		const std::size_t T = static_cast<std::size_t>(omp_get_num_threads());
+		const std::size_t t = static_cast<std::size_t>(omp_get_thread_num());
+		const std::size_t lo = m * t / T;
+		const std::size_t hi = m * (t + 1) / T;
+		std::size_t * const c_out = count_out.data() + t * n;
+		std::size_t * const c_in = directed ? count_in.data() + t * n : c_out;
+
+		std::fill(c_out, c_out + n, 0);
+		if (directed) {
+			std::fill(c_in, c_in + n, 0);
+		}
+		for (std::size_t i = lo; i < hi; ++i) {
+			++c_out[edges[i].first];
+			++c_in[edges[i].second];
+		}
+#pragma omp barrier
+
+		// turn the counts into positions, and allocate every list
+#pragma omp for schedule(static)
+		for (lal::node u = 0; u < n; ++u) {
+			std::size_t pos_out = 0;
+			std::size_t pos_in = 0;
+			for (std::size_t s = 0; s < T; ++s) {
+				std::size_t& co = count_out[s * n + u];
+				const std::size_t r = co;
+				co = pos_out;
+				pos_out += r;
+				if (directed) {
+					std::size_t& ci = count_in[s * n + u];
+					const std::size_t q = ci;
+					ci = pos_in;
+					pos_in += q;
+				}
+			}
+			out[u].resize(pos_out);
+			if (directed) {
+				in[u].resize(pos_in);
+			}
+		}
+
+		// the implicit barrier of the loop above separates both phases
+		if (directed) {
+			for (std::size_t i = lo; i < hi; ++i) {
+				const auto [u, v] = edges[i];
+				out[u][c_out[u]++] = v;
+				in[v][c_in[v]++] = u;
+			}
+		}
+		else {
+			for (std::size_t i = lo; i < hi; ++i) {
+				const auto [u, v] = edges[i];
+				out[u][c_out[u]++] = v;
+				out[v][c_out[v]++] = u;
+			}
+		}
+	}
+}
+
+} // namespace graphs
+} // namespace profiling
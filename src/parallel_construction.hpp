@@ -0,0 +1,69 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <vector>
+
+// lal includes
+#include <lal/basic_types.hpp>
+
+namespace profiling {
+namespace graphs {
+
+/*
+ * Construction of adjacency lists from an edge list with several threads.
+ *
+ * The edges are split into one contiguous chunk per thread, and every thread
+ * counts the degrees of the vertices in its chunk in its own histogram. A
+ * prefix sum over the threads, for every vertex, gives every thread the
+ * position in every list where its first neighbour goes, and every list is
+ * allocated once, with its final size. Then every thread scatters its chunk
+ * into the lists. No two threads write the same position, and the neighbours
+ * in every list are in the order of the edges, which is the order in which
+ * LAL's graphs store them when built from the same edge list.
+ *
+ * The histograms take num_threads * n counters (twice as many for directed
+ * graphs).
+ */
+
+// Builds the lists of a graph with n vertices. For undirected graphs, 'out'
+// holds the neighbours of every vertex and 'in' is left empty. For directed
+// graphs, 'out' holds the out-neighbours and 'in' the in-neighbours.
+void build_adjacency_lists(
+	const uint64_t n,
+	const lal::edge_list& edges,
+	const bool directed,
+	const int num_threads,
+	std::vector<lal::neighbourhood>& out,
+	std::vector<lal::neighbourhood>& in
+) noexcept;
+
+} // namespace graphs
+} // namespace profiling
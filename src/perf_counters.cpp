@@ -0,0 +1,109 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "perf_counters.hpp"
+
+// C++ includes
+#include <cstring>
+
+// C includes
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace profiling {
+namespace perf {
+
+namespace {
+
+[[nodiscard]] int open_counter(const uint64_t config) noexcept
+{
+	perf_event_attr attr;
+	std::memset(&attr, 0, sizeof(attr));
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.size = sizeof(attr);
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	// this thread, any CPU
+	return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+[[nodiscard]] uint64_t read_counter(const int fd) noexcept
+{
+	uint64_t value = 0;
+	if (read(fd, &value, sizeof(value)) != sizeof(value)) {
+		return 0;
+	}
+	return value;
+}
+
+} // namespace
+
+cache_counters::cache_counters() noexcept
+{
+	m_references_fd = open_counter(PERF_COUNT_HW_CACHE_REFERENCES);
+	m_misses_fd = open_counter(PERF_COUNT_HW_CACHE_MISSES);
+}
+
+cache_counters::~cache_counters() noexcept
+{
+	if (m_references_fd != -1) {
+		close(m_references_fd);
+	}
+	if (m_misses_fd != -1) {
+		close(m_misses_fd);
+	}
+}
+
+void cache_counters::start() noexcept
+{
+	if (not available()) {
+		return;
+	}
+	ioctl(m_references_fd, PERF_EVENT_IOC_RESET, 0);
+	ioctl(m_misses_fd, PERF_EVENT_IOC_RESET, 0);
+	ioctl(m_references_fd, PERF_EVENT_IOC_ENABLE, 0);
+	ioctl(m_misses_fd, PERF_EVENT_IOC_ENABLE, 0);
+}
+
+void cache_counters::stop() noexcept
+{
+	if (not available()) {
+		return;
+	}
+	ioctl(m_misses_fd, PERF_EVENT_IOC_DISABLE, 0);
+	ioctl(m_references_fd, PERF_EVENT_IOC_DISABLE, 0);
+	m_references = read_counter(m_references_fd);
+	m_misses = read_counter(m_misses_fd);
+}
+
+} // namespace perf
+} // namespace profiling
@@ -0,0 +1,82 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+
+namespace profiling {
+namespace perf {
+
+/*
+ * Hardware cache counters of the calling thread, read with perf_event_open.
+ *
+ * The counters measure the last-level cache references and misses between
+ * calls to start() and stop(). When they cannot be opened (the kernel does
+ * not support them, the process runs in a container, or perf_event_paranoid
+ * forbids it), available() is false and start() and stop() do nothing.
+ */
+class cache_counters {
+public:
+
+	cache_counters() noexcept;
+	~cache_counters() noexcept;
+
+	cache_counters(const cache_counters&) = delete;
+	cache_counters& operator= (const cache_counters&) = delete;
+
+	[[nodiscard]] bool available() const noexcept
+	{
+		return m_references_fd != -1 and m_misses_fd != -1;
+	}
+
+	// Resets and enables the counters.
+	void start() noexcept;
+	// Disables the counters and reads them.
+	void stop() noexcept;
+
+	[[nodiscard]] uint64_t get_references() const noexcept
+	{
+		return m_references;
+	}
+	[[nodiscard]] uint64_t get_misses() const noexcept
+	{
+		return m_misses;
+	}
+
+private:
+
+	int m_references_fd = -1;
+	int m_misses_fd = -1;
+
+	uint64_t m_references = 0;
+	uint64_t m_misses = 0;
+};
+
+} // namespace perf
+} // namespace profiling
@@ -0,0 +1,328 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// lal includes
+#include <lal/graphs/free_tree.hpp>
+#include <lal/graphs/rooted_tree.hpp>
+#include <lal/graphs/undirected_graph.hpp>
+#include <lal/properties/D_rla.hpp>
+
+// common includes
+#include "time.hpp"
+#include "generate_tree_shapes.hpp"
+#include "properties_D_rla_cache.hpp"
+#include "properties_D_rla_pp.hpp"
+
+namespace profiling {
+namespace properties_D_rla {
+
+namespace {
+
+// Time (in milliseconds) to call f on every graph.
+template <class graph_t, typename Callable>
+[[nodiscard]] double
+for_all_graphs(const std::vector<graph_t>& graphs, const Callable& f) noexcept
+{
+	const auto begin = profiling::now();
+	for (std::size_t i = 0; i < graphs.size(); ++i) {
+		f(i, graphs[i]);
+	}
+	const auto end = profiling::now();
+	return profiling::elapsed_time(begin, end);
+}
+
+[[nodiscard]] bool close(const double a, const double b) noexcept
+{
+	return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(a));
+}
+
+// Checks the closed forms of graph i against LAL's results.
+void check(
+	const std::string& what,
+	const std::size_t i,
+	const D_rla_moments& lal_res,
+	const D_rla_moments& res
+) noexcept
+{
+	if (res.exp_rational != lal_res.exp_rational or
+		res.var_rational != lal_res.var_rational or
+		not close(lal_res.exp, res.exp) or not close(lal_res.var, res.var)) {
+		std::cerr << "ERROR! The " << what << " and LAL disagree on graph " << i
+				  << ".\n";
+		std::cerr << "    LAL: E[D]= " << lal_res.exp_rational.to_string()
+				  << " V[D]= " << lal_res.var_rational.to_string() << '\n';
+		std::cerr << "    " << what
+				  << ": E[D]= " << res.exp_rational.to_string()
+				  << " V[D]= " << res.var_rational.to_string() << '\n';
+		std::abort();
+	}
+}
+
+// Profiles E[D] and V[D] on all graphs, and the expectations in projective
+// and planar arrangements when the graphs are trees.
+template <class graph_t>
+void profile(
+	const properties_D_rla_pp& parser, const std::vector<graph_t>& graphs
+) noexcept
+{
+	static constexpr bool is_tree =
+		std::is_same_v<graph_t, lal::graphs::free_tree>;
+
+	const std::string& mode = parser.get_mode();
+	const bool with_lal = mode != "cached";
+	const bool with_cache = mode != "lal";
+	const std::size_t T = graphs.size();
+
+	std::cout << "Number of vertices (n)= " << parser.get_n() << '\n';
+	std::cout << "Number of graphs generated (T)= " << T << '\n';
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(24) << "function" << std::setw(24) << "total"
+			  << std::setw(16) << "ns/graph" << '\n';
+	std::cout << "------------------------\n";
+
+	const auto output_row = [&](const std::string& name, const double ms)
+	{
+		std::cout << std::setw(24) << name << std::setw(24)
+				  << profiling::time_to_str(ms) << std::setw(16)
+				  << ms * 1'000'000.0 / static_cast<double>(T) << '\n';
+	};
+
+	std::vector<D_rla_moments> lal_res(T);
+	if (with_lal) {
+		output_row(
+			"E[D] rational",
+			for_all_graphs(
+				graphs,
+				[&](const std::size_t i, const graph_t& g)
+				{
+					lal_res[i].exp_rational =
+						lal::properties::exp_sum_edge_lengths_rational(g);
+				}
+			)
+		);
+		output_row(
+			"V[D] rational",
+			for_all_graphs(
+				graphs,
+				[&](const std::size_t i, const graph_t& g)
+				{
+					lal_res[i].var_rational =
+						lal::properties::var_sum_edge_lengths_rational(g);
+				}
+			)
+		);
+		output_row(
+			"E[D] double",
+			for_all_graphs(
+				graphs,
+				[&](const std::size_t i, const graph_t& g)
+				{
+					lal_res[i].exp = lal::properties::exp_sum_edge_lengths(g);
+				}
+			)
+		);
+		output_row(
+			"V[D] double",
+			for_all_graphs(
+				graphs,
+				[&](const std::size_t i, const graph_t& g)
+				{
+					lal_res[i].var = lal::properties::var_sum_edge_lengths(g);
+				}
+			)
+		);
+
+		if constexpr (is_tree) {
+			std::vector<lal::graphs::rooted_tree> rooted;
+			rooted.reserve(T);
+			for (const graph_t& t : graphs) {
+				rooted.emplace_back(t, 0);
+			}
+
+			double sum = 0;
+			output_row(
+				"E_pr[D] rational",
+				for_all_graphs(
+					rooted,
+					[&](const std::size_t, const lal::graphs::rooted_tree& t)
+					{
+						sum += lal::properties::
+								   exp_sum_edge_lengths_projective_rational(t)
+									   .to_double();
+					}
+				)
+			);
+			output_row(
+				"E_pr[D] double",
+				for_all_graphs(
+					rooted,
+					[&](const std::size_t, const lal::graphs::rooted_tree& t)
+					{
+						sum +=
+							lal::properties::exp_sum_edge_lengths_projective(t);
+					}
+				)
+			);
+			output_row(
+				"E_pl[D] rational",
+				for_all_graphs(
+					graphs,
+					[&](const std::size_t, const graph_t& t)
+					{
+						sum += lal::properties::
+								   exp_sum_edge_lengths_planar_rational(t)
+									   .to_double();
+					}
+				)
+			);
+			output_row(
+				"E_pl[D] double",
+				for_all_graphs(
+					graphs,
+					[&](const std::size_t, const graph_t& t)
+					{
+						sum += lal::properties::exp_sum_edge_lengths_planar(t);
+					}
+				)
+			);
+			if (sum < 0) {
+				std::cout << sum << '\n';
+			}
+		}
+	}
+
+	if (with_cache) {
+		// E[D] and V[D] together, in both forms
+		std::vector<D_rla_moments> res(T);
+		output_row(
+			"closed form",
+			for_all_graphs(
+				graphs,
+				[&](const std::size_t i, const graph_t& g)
+				{
+					const uint64_t n = g.get_num_nodes();
+					uint64_t S = 0;
+					for (lal::node u = 0; u < n; ++u) {
+						S += g.get_degree(u) * g.get_degree(u);
+					}
+					res[i] = D_rla_closed_form(n, g.get_num_edges(), S);
+				}
+			)
+		);
+		if (with_lal) {
+			for (std::size_t i = 0; i < T; ++i) {
+				check("closed form", i, lal_res[i], res[i]);
+			}
+		}
+
+		D_rla_cache C;
+		output_row(
+			"cached",
+			for_all_graphs(
+				graphs,
+				[&](const std::size_t i, const graph_t& g)
+				{
+					res[i] = C.get(g);
+				}
+			)
+		);
+		if (with_lal) {
+			for (std::size_t i = 0; i < T; ++i) {
+				check("cache", i, lal_res[i], res[i]);
+			}
+		}
+
+		std::cout << "------------------------\n";
+		std::cout << "Distinct degree sequences= " << C.size() << '\n';
+		std::cout << "Cache hits= " << C.get_num_hits() << '\n';
+		std::cout << "Cache misses= " << C.get_num_misses() << '\n';
+	}
+}
+
+} // namespace
+
+} // namespace properties_D_rla
+
+void properties_D_rla_graph(uint64_t argc, char *argv[]) noexcept
+{
+	properties_D_rla::properties_D_rla_pp parser(argc, argv);
+	{
+		if (parser.parse_params() > 0) {
+			return;
+		}
+		if (parser.check_errors() > 0) {
+			return;
+		}
+	}
+
+	const uint64_t n = parser.get_n();
+	const uint64_t T = parser.get_T();
+
+	if (parser.get_graph_class() == "tree") {
+		generate::tree_shape_generator<lal::graphs::free_tree> Gen(
+			n, parser.get_shape(), 1234
+		);
+
+		std::vector<lal::graphs::free_tree> trees;
+		trees.reserve(T);
+		for (uint64_t i = 0; i < T; ++i) {
+			trees.push_back(Gen.get_tree());
+		}
+		properties_D_rla::profile(parser, trees);
+	}
+	else {
+		std::mt19937 gen(1234);
+		std::bernoulli_distribution d(parser.get_p());
+
+		std::vector<lal::graphs::undirected_graph> graphs(
+			T, lal::graphs::undirected_graph(n)
+		);
+		for (lal::graphs::undirected_graph& g : graphs) {
+			for (lal::node u = 0; u < n; ++u) {
+				for (lal::node v = u + 1; v < n; ++v) {
+					if (d(gen)) {
+						g.add_edge_bulk(u, v);
+					}
+				}
+			}
+			g.finish_bulk_add(true, false);
+		}
+		properties_D_rla::profile(parser, graphs);
+	}
+}
+
+} // namespace profiling
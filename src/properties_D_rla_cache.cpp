@@ -0,0 +1,117 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "properties_D_rla_cache.hpp"
+
+// lal includes
+#include <lal/numeric/integer.hpp>
+
+namespace profiling {
+namespace properties_D_rla {
+
+D_rla_moments
+D_rla_closed_form(const uint64_t n, const uint64_t m, const uint64_t S) noexcept
+{
+	D_rla_moments res;
+
+	lal::numeric::integer num_E(m);
+	num_E *= n + 1;
+	res.exp_rational = lal::numeric::rational(num_E, 3);
+
+	// S(n - 4) may be negative
+	lal::numeric::integer num_V(S);
+	num_V *= static_cast<int64_t>(n) - 4;
+	num_V += lal::numeric::integer(m) * (8 * (n - 1));
+	num_V -= lal::numeric::integer(m) * (4 * m);
+	num_V *= n + 1;
+	res.var_rational = lal::numeric::rational(num_V, 180);
+
+	const double dn = static_cast<double>(n);
+	const double dm = static_cast<double>(m);
+	const double dS = static_cast<double>(S);
+	res.exp = dm * (dn + 1) / 3;
+	res.var =
+		(dn + 1) * (dS * (dn - 4) + 8 * dm * (dn - 1) - 4 * dm * dm) / 180;
+	return res;
+}
+
+std::size_t
+D_rla_cache::key_hash::operator()(const std::vector<uint64_t>& key)
+	const noexcept
+{
+	// splitmix64's finaliser over the sequence
+	uint64_t h = key.size();
+	for (const uint64_t x : key) {
+		h ^= x + 0x9e3779b97f4a7c15;
+		h ^= h >> 30;
+		h *= 0xbf58476d1ce4e5b9;
+		h ^= h >> 27;
+		h *= 0x94d049bb133111eb;
+		h ^= h >> 31;
+	}
+	return h;
+}
+
+const D_rla_moments&
+D_rla_cache::get(const lal::graphs::undirected_graph& g) noexcept
+{
+	const uint64_t n = g.get_num_nodes();
+	if (m_count.size() < n) {
+		m_count.resize(n, 0);
+	}
+
+	for (lal::node u = 0; u < n; ++u) {
+		++m_count[g.get_degree(u)];
+	}
+	// build the key and leave the histogram empty for the next graph
+	m_key.clear();
+	for (uint64_t d = 0; d < n; ++d) {
+		if (m_count[d] > 0) {
+			m_key.push_back(d);
+			m_key.push_back(m_count[d]);
+			m_count[d] = 0;
+		}
+	}
+
+	const auto it = m_table.find(m_key);
+	if (it != m_table.end()) {
+		++m_hits;
+		return it->second;
+	}
+
+	++m_misses;
+	uint64_t S = 0;
+	for (std::size_t i = 0; i < m_key.size(); i += 2) {
+		S += m_key[i] * m_key[i] * m_key[i + 1];
+	}
+	return m_table
+		.emplace(m_key, D_rla_closed_form(n, g.get_num_edges(), S))
+		.first->second;
+}
+
+} // namespace properties_D_rla
+} // namespace profiling
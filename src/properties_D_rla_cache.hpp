@@ -0,0 +1,111 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// lal includes
+#include <lal/graphs/undirected_graph.hpp>
+#include <lal/numeric/rational.hpp>
+
+namespace profiling {
+namespace properties_D_rla {
+
+// Expectation and variance of the sum of edge lengths D in uniformly random
+// linear arrangements, exact and in floating point.
+struct D_rla_moments {
+	lal::numeric::rational exp_rational;
+	lal::numeric::rational var_rational;
+	double exp = 0;
+	double var = 0;
+};
+
+/*
+ * Closed forms of E[D] and V[D] from the degree sequence.
+ *
+ * With n vertices, m edges and S the sum of the squared degrees,
+ *     E[D] = m(n + 1)/3,
+ *     V[D] = (n + 1)(S(n - 4) + 8m(n - 1) - 4m^2)/180,
+ * which follow from the variance of the length of an edge, (n + 1)(n - 2)/18,
+ * and the covariances of the lengths of two edges that share a vertex,
+ * (n + 1)(n - 8)/180, and of two disjoint edges, -(n + 1)/45.
+ */
+[[nodiscard]] D_rla_moments D_rla_closed_form(
+	const uint64_t n, const uint64_t m, const uint64_t S
+) noexcept;
+
+/*
+ * Memoisation of the closed forms by degree sequence.
+ *
+ * E[D] and V[D] depend only on the degree sequence of the graph. The key of
+ * a graph is its degree histogram, as a list of pairs (degree, number of
+ * vertices), which takes linear time to build. The rational arithmetic is
+ * only done the first time a degree sequence is seen.
+ */
+class D_rla_cache {
+public:
+
+	[[nodiscard]] const D_rla_moments&
+	get(const lal::graphs::undirected_graph& g) noexcept;
+
+	[[nodiscard]] uint64_t get_num_hits() const noexcept
+	{
+		return m_hits;
+	}
+	[[nodiscard]] uint64_t get_num_misses() const noexcept
+	{
+		return m_misses;
+	}
+	[[nodiscard]] std::size_t size() const noexcept
+	{
+		return m_table.size();
+	}
+
+private:
+
+	struct key_hash {
+		[[nodiscard]] std::size_t
+		operator()(const std::vector<uint64_t>& key) const noexcept;
+	};
+
+	// number of vertices of every degree
+	std::vector<uint64_t> m_count;
+	// key of the last graph
+	std::vector<uint64_t> m_key;
+
+	std::unordered_map<std::vector<uint64_t>, D_rla_moments, key_hash> m_table;
+
+	uint64_t m_hits = 0;
+	uint64_t m_misses = 0;
+};
+
+} // namespace properties_D_rla
+} // namespace profiling
@@ -0,0 +1,175 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "properties_D_rla_pp.hpp"
+
+// C++ includes
+#include <cstdlib>
+#include <iostream>
+
+namespace profiling {
+namespace properties_D_rla {
+
+properties_D_rla_pp::properties_D_rla_pp(uint64_t argc, char *argv[]) noexcept
+	: m_argc(argc),
+	  m_argv(argv)
+{ }
+
+void properties_D_rla_pp::print_usage() const noexcept
+{
+	// clang-format off
+	std::cout << "Profiling -- Expectation and variance of D in random arrangements\n";
+	std::cout << "=================================================================\n";
+	std::cout << '\n';
+	std::cout << "This program's options are the following:\n";
+	std::cout << "    Those marked with [*] are mandatory for all execution modes.\n";
+	std::cout << "    Those marked with [i] are mandatory for execution mode i.\n";
+	std::cout << "    Those marked with [?] are optional.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -n n\n";
+	std::cout << "          Indicate the number of vertices of the graphs.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -T T\n";
+	std::cout << "          Indicate the number of graphs to generate.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -class c\n";
+	std::cout << "          The class of the graphs:\n";
+	std::cout << "              tree : random unlabelled free trees. Also profiles\n";
+	std::cout << "                  E[D] in random projective (rooted at vertex 0)\n";
+	std::cout << "                  and planar arrangements.\n";
+	std::cout << "              graph : Erdos-Renyi graphs G(n,p).\n";
+	std::cout << "          Default: tree\n";
+	std::cout << '\n';
+	std::cout << "    [graph] -p p\n";
+	std::cout << "          Probability of every edge of the graphs.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -mode m\n";
+	std::cout << "          How E[D] and V[D] are computed:\n";
+	std::cout << "              lal : LAL's functions, rational and double.\n";
+	std::cout << "              cached : the closed forms from the degree sequence,\n";
+	std::cout << "                  without and with memoisation by degree sequence.\n";
+	std::cout << "              both : both of the above, checking the results of\n";
+	std::cout << "                  the closed forms against LAL's.\n";
+	std::cout << "          Default: both\n";
+	std::cout << '\n';
+	generate::print_tree_shape_usage();
+	// clang-format on
+}
+
+int properties_D_rla_pp::parse_params() noexcept
+{
+	if (m_argc == 0) {
+		print_usage();
+		return 1;
+	}
+
+	for (uint64_t i = 0; i < m_argc; ++i) {
+		const std::string param(m_argv[i]);
+
+		if (param == "--help" or param == "-h") {
+			print_usage();
+			return 1;
+		}
+		else if (param == "-n") {
+			m_n = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_has_n = true;
+			++i;
+		}
+		else if (param == "-T") {
+			m_T = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_has_T = true;
+			++i;
+		}
+		else if (param == "-class") {
+			m_graph_class = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-p") {
+			m_p = atof(m_argv[i + 1]);
+			m_has_p = true;
+			++i;
+		}
+		else if (param == "-mode") {
+			m_mode = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-shape") {
+			if (not generate::parse_tree_shape(m_argv[i + 1], m_shape)) {
+				std::cerr << "Error: wrong value for parameter '-shape'.\n";
+				std::cerr << "    Value: '" << m_argv[i + 1] << "'\n";
+				return 2;
+			}
+			++i;
+		}
+		else {
+			std::cerr << "Error: unrecognised option\n";
+			std::cerr << "    " << param << '\n';
+			return 2;
+		}
+	}
+	return 0;
+}
+
+int properties_D_rla_pp::check_errors() const noexcept
+{
+	if (not m_has_n) {
+		std::cout << "Error: missing parameter '-n'.\n";
+		return 1;
+	}
+	if (not m_has_T) {
+		std::cout << "Error: missing parameter '-T'.\n";
+		return 1;
+	}
+	if (m_n == 0) {
+		std::cout << "Error: the graphs must have at least one vertex.\n";
+		return 1;
+	}
+	if (m_graph_class != "tree" and m_graph_class != "graph") {
+		std::cout << "Error: wrong value for parameter '-class'.\n";
+		std::cout << "    Value: '" << m_graph_class << "'\n";
+		return 1;
+	}
+	if (m_graph_class == "graph") {
+		if (not m_has_p) {
+			std::cout << "Error: missing parameter '-p'.\n";
+			return 1;
+		}
+		if (m_p < 0 or m_p > 1) {
+			std::cout << "Error: the probability must be in [0,1].\n";
+			return 1;
+		}
+	}
+	if (m_mode != "lal" and m_mode != "cached" and m_mode != "both") {
+		std::cout << "Error: wrong value for parameter '-mode'.\n";
+		std::cout << "    Value: '" << m_mode << "'\n";
+		return 1;
+	}
+	return 0;
+}
+
+} // namespace properties_D_rla
+} // namespace profiling
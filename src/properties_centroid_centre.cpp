@@ -26,17 +26,22 @@
  ***********************************************************************/
 
 // C++ includes
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <span>
+#include <vector>
 
 // lal includes
-#include <lal/generate/tree_generator_type.hpp>
 #include <lal/graphs/free_tree.hpp>
 #include <lal/properties/tree_centroid.hpp>
 #include <lal/properties/tree_centre.hpp>
 
 // common includes
 #include "time.hpp"
+#include "generate_tree_shapes.hpp"
 #include "properties_centroid_centre_pp.hpp"
+#include "tree_centroid_centre.hpp"
 
 namespace profiling {
 namespace properties_centroid_centre {
@@ -57,56 +62,124 @@ void output_execution_time(
 	std::cout << "    Average (ms/tree): "
 			  << profiling::time_to_str(totallocal_ms / static_cast<double>(T))
 			  << '\n';
+	std::cout << "    Average (ns/tree): " << std::fixed << std::setprecision(2)
+			  << totallocal_ms * 1'000'000.0 / static_cast<double>(T) << '\n';
 }
 
-} // namespace properties_centroid_centre
+// The pair of vertices with the smallest first, and with the second equal
+// to n when there is only one vertex.
+[[nodiscard]] std::pair<lal::node, lal::node>
+normalise(std::pair<lal::node, lal::node> p, const uint64_t n) noexcept
+{
+	if (p.second >= n) {
+		p.second = n;
+	}
+	else if (p.second < p.first) {
+		std::swap(p.first, p.second);
+	}
+	return p;
+}
 
-void properties_centroid_tree(uint64_t argc, char *argv[]) noexcept
+// Computes the centroid (or the centre) of T random trees in the mode
+// given in the parameters.
+template <bool centroid>
+void profile(const properties_centroid_centre_pp& parser) noexcept
 {
-	properties_centroid_centre::properties_centroid_centre_pp parser(
-		argc, argv
-	);
+	const uint64_t n = parser.get_n();
+	const uint64_t T = parser.get_T();
+	const std::string& mode = parser.get_mode();
+
+	const auto with_lal = [](const lal::graphs::free_tree& t)
 	{
-		if (parser.parse_params() > 0) {
-			return;
+		if constexpr (centroid) {
+			return lal::properties::tree_centroid(t);
 		}
-		if (parser.check_errors() > 0) {
-			return;
+		else {
+			return lal::properties::tree_centre(t);
 		}
-	}
+	};
 
-	const uint64_t n = parser.get_n();
-	const uint64_t T = parser.get_T();
+	workspace W;
+	const auto check = [&](const lal::graphs::free_tree& t,
+						   const std::pair<lal::node, lal::node>& res)
+	{
+		if (normalise(with_lal(t), n) != normalise(res, n)) {
+			std::cerr << "ERROR! The workspace and LAL disagree.\n";
+			std::abort();
+		}
+	};
 
 	double totallocal = 0.0;
 
-	lal::generate::tree_generator_type_t<
-		lal::generate::random_t,
-		lal::generate::unlabelled_t,
-		lal::graphs::free_tree>
-		Gen(n, 1234);
+	generate::tree_shape_generator<lal::graphs::free_tree> Gen(
+		n, parser.get_shape(), 1234
+	);
 
 	const auto beginglobal = profiling::now();
-	for (uint64_t t = 0; t < T; ++t) {
-		const auto tree = Gen.get_tree();
+	if (mode == "lal") {
+		for (uint64_t t = 0; t < T; ++t) {
+			const auto tree = Gen.get_tree();
 
-		const auto beginlocal = profiling::now();
-		auto res = lal::properties::tree_centroid(tree);
-		const auto endlocal = profiling::now();
-		totallocal += profiling::elapsed_time(beginlocal, endlocal);
+			const auto beginlocal = profiling::now();
+			auto res = with_lal(tree);
+			const auto endlocal = profiling::now();
+			totallocal += profiling::elapsed_time(beginlocal, endlocal);
 
-		res.first += 3;
-		res.first += 4;
+			res.first += 3;
+			res.first += 4;
+		}
+	}
+	else if (mode == "workspace") {
+		for (uint64_t t = 0; t < T; ++t) {
+			const auto tree = Gen.get_tree();
+
+			const auto beginlocal = profiling::now();
+			const auto res = centroid ? W.centroid(tree) : W.centre(tree);
+			const auto endlocal = profiling::now();
+			totallocal += profiling::elapsed_time(beginlocal, endlocal);
+
+			check(tree, res);
+		}
+	}
+	else if (mode == "batch") {
+		const uint64_t B = parser.get_batch_size();
+		std::vector<lal::graphs::free_tree> trees;
+		std::vector<std::pair<lal::node, lal::node>> res(B);
+		for (uint64_t t = 0; t < T; t += B) {
+			const uint64_t b = std::min(B, T - t);
+			trees.clear();
+			for (uint64_t i = 0; i < b; ++i) {
+				trees.push_back(Gen.get_tree());
+			}
+
+			const std::span<const lal::graphs::free_tree> in(trees);
+			const std::span<std::pair<lal::node, lal::node>> out(
+				res.data(), b
+			);
+			const auto beginlocal = profiling::now();
+			if constexpr (centroid) {
+				W.centroid(in, out);
+			}
+			else {
+				W.centre(in, out);
+			}
+			const auto endlocal = profiling::now();
+			totallocal += profiling::elapsed_time(beginlocal, endlocal);
+
+			for (uint64_t i = 0; i < b; ++i) {
+				check(trees[i], res[i]);
+			}
+		}
 	}
 	const auto endglobal = profiling::now();
 	const double totalglobal = profiling::elapsed_time(beginglobal, endglobal);
 
-	properties_centroid_centre::output_execution_time(
-		totalglobal, totallocal, n, T
-	);
+	output_execution_time(totalglobal, totallocal, n, T);
 }
 
-void properties_centre_tree(uint64_t argc, char *argv[]) noexcept
+} // namespace properties_centroid_centre
+
+void properties_centroid_tree(uint64_t argc, char *argv[]) noexcept
 {
 	properties_centroid_centre::properties_centroid_centre_pp parser(
 		argc, argv
@@ -120,35 +193,24 @@ void properties_centre_tree(uint64_t argc, char *argv[]) noexcept
 		}
 	}
 
-	const uint64_t n = parser.get_n();
-	const uint64_t T = parser.get_T();
-
-	double totallocal = 0.0;
-
-	lal::generate::tree_generator_type_t<
-		lal::generate::random_t,
-		lal::generate::unlabelled_t,
-		lal::graphs::free_tree>
-		Gen(n, 1234);
-
-	const auto beginglobal = profiling::now();
-	for (uint64_t t = 0; t < T; ++t) {
-		const auto tree = Gen.get_tree();
-
-		const auto beginlocal = profiling::now();
-		auto res = lal::properties::tree_centre(tree);
-		const auto endlocal = profiling::now();
-		totallocal += profiling::elapsed_time(beginlocal, endlocal);
+	properties_centroid_centre::profile<true>(parser);
+}
 
-		res.first += 3;
-		res.first += 4;
+void properties_centre_tree(uint64_t argc, char *argv[]) noexcept
+{
+	properties_centroid_centre::properties_centroid_centre_pp parser(
+		argc, argv
+	);
+	{
+		if (parser.parse_params() > 0) {
+			return;
+		}
+		if (parser.check_errors() > 0) {
+			return;
+		}
 	}
-	const auto endglobal = profiling::now();
-	const double totalglobal = profiling::elapsed_time(beginglobal, endglobal);
 
-	properties_centroid_centre::output_execution_time(
-		totalglobal, totallocal, n, T
-	);
+	properties_centroid_centre::profile<false>(parser);
 }
 
 } // namespace profiling
@@ -53,11 +53,27 @@ void properties_centroid_centre_pp::print_usage() const noexcept
 	std::cout << "    Those marked with [?] are optional.\n";
 	std::cout << '\n';
 	std::cout << "    [*]   -n n\n";
-	std::cout << "          Indicate the number of vertices of the trees.\n";
+	std::cout << "          Indicate the number of vertices of the trees (at least 1).\n";
 	std::cout << '\n';
 	std::cout << "    [*]   -T T\n";
 	std::cout << "          Indicate the number of trees to generate.\n";
 	std::cout << '\n';
+	std::cout << "    [?]   -mode m\n";
+	std::cout << "          How the centroid or the centre is computed:\n";
+	std::cout << "              lal : one call to LAL's function per tree.\n";
+	std::cout << "              workspace : one call per tree to a workspace\n";
+	std::cout << "                  that keeps its buffers across calls.\n";
+	std::cout << "              batch : the trees are generated in batches, and\n";
+	std::cout << "                  every batch is passed to the workspace at once.\n";
+	std::cout << "          In modes workspace and batch the results are checked\n";
+	std::cout << "          against LAL's, outside the timed region.\n";
+	std::cout << "          Default: lal\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -batch B\n";
+	std::cout << "          Number of trees of every batch in mode 'batch'.\n";
+	std::cout << "          Default: 1024\n";
+	std::cout << '\n';
+	generate::print_tree_shape_usage();
 	// clang-format on
 }
 
@@ -85,6 +101,22 @@ int properties_centroid_centre_pp::parse_params() noexcept
 			m_has_T = true;
 			++i;
 		}
+		else if (param == "-mode") {
+			m_mode = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-batch") {
+			m_batch_size = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			++i;
+		}
+		else if (param == "-shape") {
+			if (not generate::parse_tree_shape(m_argv[i + 1], m_shape)) {
+				std::cerr << "Error: wrong value for parameter '-shape'.\n";
+				std::cerr << "    Value: '" << m_argv[i + 1] << "'\n";
+				return 2;
+			}
+			++i;
+		}
 		else {
 			std::cerr << "Error: unrecognised option\n";
 			std::cerr << "    " << param << '\n';
@@ -100,10 +132,23 @@ int properties_centroid_centre_pp::check_errors() const noexcept
 		std::cout << "Error: missing parameter '-n'.\n";
 		return 1;
 	}
+	if (m_n < 1) {
+		std::cout << "Error: the trees must have at least one vertex.\n";
+		return 1;
+	}
 	if (not m_has_T) {
 		std::cout << "Error: missing parameter '-R'.\n";
 		return 1;
 	}
+	if (m_mode != "lal" and m_mode != "workspace" and m_mode != "batch") {
+		std::cout << "Error: wrong value for parameter '-mode'.\n";
+		std::cout << "    Value: '" << m_mode << "'\n";
+		return 1;
+	}
+	if (m_batch_size == 0) {
+		std::cout << "Error: the batch size must be positive.\n";
+		return 1;
+	}
 	return 0;
 }
 
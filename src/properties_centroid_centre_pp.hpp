@@ -29,6 +29,10 @@
 
 // C++ includes
 #include <cstdint>
+#include <string>
+
+// common includes
+#include "tree_shape.hpp"
 
 namespace profiling {
 namespace properties_centroid_centre {
@@ -47,6 +51,18 @@ public:
 	{
 		return m_T;
 	}
+	[[nodiscard]] const std::string& get_mode() const noexcept
+	{
+		return m_mode;
+	}
+	[[nodiscard]] constexpr uint64_t get_batch_size() const noexcept
+	{
+		return m_batch_size;
+	}
+	[[nodiscard]] const generate::tree_shape& get_shape() const noexcept
+	{
+		return m_shape;
+	}
 
 	void print_usage() const noexcept;
 
@@ -69,6 +85,15 @@ private:
 	uint64_t m_T = 0;
 	bool m_has_T = false;
 
+	// how the centroid or centre is computed
+	std::string m_mode = "lal";
+
+	// number of trees of every batch in mode 'batch'
+	uint64_t m_batch_size = 1024;
+
+	// shape of the trees
+	generate::tree_shape m_shape;
+
 	uint64_t m_argc;
 	char **m_argv;
 };
@@ -0,0 +1,290 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// lal includes
+#include <lal/graphs/free_tree.hpp>
+#include <lal/graphs/rooted_tree.hpp>
+#include <lal/properties/branchless_paths_compute.hpp>
+#include <lal/properties/hierarchical_distance.hpp>
+#include <lal/properties/tree_caterpillar_distance.hpp>
+#include <lal/properties/tree_diameter.hpp>
+
+// omp includes
+#include <omp.h>
+
+// common includes
+#include "time.hpp"
+#include "generate_tree_shapes.hpp"
+#include "properties_suite_pp.hpp"
+#include "tree_properties_fused.hpp"
+
+namespace profiling {
+namespace properties_suite {
+
+namespace {
+
+// Time (in milliseconds) to call f(i) for every tree i in [0, T), with the
+// trees split among P threads.
+template <typename Callable>
+[[nodiscard]] double
+for_all_trees(const uint64_t T, const int P, const Callable& f) noexcept
+{
+	const auto begin = profiling::now();
+#pragma omp parallel for num_threads(P) schedule(static)
+	for (uint64_t i = 0; i < T; ++i) {
+		f(i);
+	}
+	const auto end = profiling::now();
+	return profiling::elapsed_time(begin, end);
+}
+
+// Checks the value of property 'p' computed by the fused traversal against
+// LAL's.
+void check(
+	const std::string& p,
+	const uint64_t i,
+	const tree_properties& lal_res,
+	const tree_properties& fused_res
+) noexcept
+{
+	bool equal = true;
+	if (p == "mhd") {
+		const double a = lal_res.mean_hierarchical_distance;
+		const double b = fused_res.mean_hierarchical_distance;
+		equal = std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(a));
+	}
+	else if (p == "diameter") {
+		equal = lal_res.diameter == fused_res.diameter;
+	}
+	else if (p == "caterpillar") {
+		equal = lal_res.caterpillar_distance == fused_res.caterpillar_distance;
+	}
+	else if (p == "branchless") {
+		equal = lal_res.num_branchless_paths == fused_res.num_branchless_paths;
+	}
+	else if (p == "subtree") {
+		equal = lal_res.max_subtree_size == fused_res.max_subtree_size;
+	}
+
+	if (not equal) {
+		std::cerr << "ERROR! The fused traversal and LAL disagree on property '"
+				  << p << "' of tree " << i << ".\n";
+		std::abort();
+	}
+}
+
+} // namespace
+
+void profile(const properties_suite_pp& parser) noexcept
+{
+	const uint64_t n = parser.get_n();
+	const uint64_t T = parser.get_T();
+	const int P = static_cast<int>(parser.get_threads());
+	const std::vector<std::string>& properties = parser.get_properties();
+	const std::string& mode = parser.get_mode();
+	const bool separate = mode != "fused";
+	const bool fused = mode != "separate";
+
+	// the same stream of trees for all properties
+	std::vector<lal::graphs::free_tree> trees;
+	std::vector<lal::graphs::rooted_tree> rooted;
+	{
+		generate::tree_shape_generator<lal::graphs::free_tree> Gen(
+			n, parser.get_shape(), 1234
+		);
+
+		trees.reserve(T);
+		rooted.reserve(T);
+		for (uint64_t i = 0; i < T; ++i) {
+			trees.push_back(Gen.get_tree());
+			rooted.emplace_back(trees.back(), 0);
+		}
+	}
+
+	const auto ns_per_tree = [&](const double ms)
+	{
+		return ms * 1'000'000.0 / static_cast<double>(T);
+	};
+
+	std::cout << "Number of vertices (n)= " << n << '\n';
+	std::cout << "Number of trees generated (T)= " << T << '\n';
+	std::cout << "Number of threads (P)= " << P << '\n';
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(16) << "property" << std::setw(24) << "total"
+			  << std::setw(16) << "ns/tree" << '\n';
+	std::cout << "------------------------\n";
+
+	const auto output_row = [&](const std::string& name, const double ms)
+	{
+		std::cout << std::setw(16) << name << std::setw(24)
+				  << profiling::time_to_str(ms) << std::setw(16)
+				  << ns_per_tree(ms) << '\n';
+	};
+
+	std::vector<tree_properties> lal_res(T);
+	double total_separate = 0;
+	if (separate) {
+		for (const std::string& p : properties) {
+			double ms = 0;
+			if (p == "mhd") {
+				ms = for_all_trees(
+					T,
+					P,
+					[&](const uint64_t i)
+					{
+						lal_res[i].mean_hierarchical_distance =
+							lal::properties::mean_hierarchical_distance(
+								rooted[i]
+							);
+					}
+				);
+			}
+			else if (p == "diameter") {
+				ms = for_all_trees(
+					T,
+					P,
+					[&](const uint64_t i)
+					{
+						lal_res[i].diameter =
+							lal::properties::tree_diameter(trees[i]);
+					}
+				);
+			}
+			else if (p == "caterpillar") {
+				ms = for_all_trees(
+					T,
+					P,
+					[&](const uint64_t i)
+					{
+						lal_res[i].caterpillar_distance =
+							lal::properties::tree_caterpillar_distance(
+								trees[i]
+							);
+					}
+				);
+			}
+			else if (p == "branchless") {
+				ms = for_all_trees(
+					T,
+					P,
+					[&](const uint64_t i)
+					{
+						lal_res[i].num_branchless_paths =
+							lal::properties::branchless_paths_compute(trees[i])
+								.size();
+					}
+				);
+			}
+			else if (p == "subtree") {
+				ms = for_all_trees(
+					T,
+					P,
+					[&](const uint64_t i)
+					{
+						rooted[i].calculate_size_subtrees();
+						uint64_t largest = 0;
+						for (lal::node u = 1; u < n; ++u) {
+							largest = std::max(
+								largest, rooted[i].get_num_nodes_subtree(u)
+							);
+						}
+						lal_res[i].max_subtree_size = largest;
+					}
+				);
+			}
+			output_row(p, ms);
+			total_separate += ms;
+		}
+		output_row("separate (sum)", total_separate);
+	}
+
+	if (fused) {
+		property_selection selected;
+		for (const std::string& p : properties) {
+			selected.mean_hierarchical_distance |= p == "mhd";
+			selected.diameter |= p == "diameter";
+			selected.caterpillar_distance |= p == "caterpillar";
+			selected.num_branchless_paths |= p == "branchless";
+			selected.max_subtree_size |= p == "subtree";
+		}
+
+		std::vector<tree_properties> fused_res(T);
+
+		const auto begin = profiling::now();
+#pragma omp parallel num_threads(P)
+		{
+			fused_traversal F(selected);
+#pragma omp for schedule(static)
+			for (uint64_t i = 0; i < T; ++i) {
+				fused_res[i] = F.compute(trees[i]);
+			}
+		}
+		const auto end = profiling::now();
+		const double ms = profiling::elapsed_time(begin, end);
+		output_row("fused", ms);
+
+		if (separate) {
+			std::cout << "------------------------\n";
+			std::cout << "Savings of the fused traversal: "
+					  << 100.0 * (total_separate - ms) / total_separate
+					  << " %\n";
+
+			for (uint64_t i = 0; i < T; ++i) {
+				for (const std::string& p : properties) {
+					check(p, i, lal_res[i], fused_res[i]);
+				}
+			}
+		}
+	}
+}
+
+} // namespace properties_suite
+
+void properties_suite_tree(uint64_t argc, char *argv[]) noexcept
+{
+	properties_suite::properties_suite_pp parser(argc, argv);
+	{
+		if (parser.parse_params() > 0) {
+			return;
+		}
+		if (parser.check_errors() > 0) {
+			return;
+		}
+	}
+
+	properties_suite::profile(parser);
+}
+
+} // namespace profiling
@@ -0,0 +1,184 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "properties_suite_pp.hpp"
+
+// C++ includes
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace profiling {
+namespace properties_suite {
+
+properties_suite_pp::properties_suite_pp(uint64_t argc, char *argv[]) noexcept
+	: m_argc(argc),
+	  m_argv(argv)
+{ }
+
+void properties_suite_pp::print_usage() const noexcept
+{
+	// clang-format off
+	std::cout << "Profiling -- Calculation of several properties of trees\n";
+	std::cout << "=======================================================\n";
+	std::cout << '\n';
+	std::cout << "This program's options are the following:\n";
+	std::cout << "    Those marked with [*] are mandatory for all execution modes.\n";
+	std::cout << "    Those marked with [i] are mandatory for execution mode i.\n";
+	std::cout << "    Those marked with [?] are optional.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -n n\n";
+	std::cout << "          Indicate the number of vertices of the trees (at least 2).\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -T T\n";
+	std::cout << "          Indicate the number of trees to generate. The same\n";
+	std::cout << "          T random trees are used for all properties.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -properties p_1,p_2,...\n";
+	std::cout << "          The properties to profile, computed with LAL:\n";
+	std::cout << "              mhd : mean hierarchical distance (root: vertex 0).\n";
+	std::cout << "              diameter : diameter of the tree.\n";
+	std::cout << "              caterpillar : caterpillar distance.\n";
+	std::cout << "              branchless : branchless paths.\n";
+	std::cout << "              subtree : sizes of the subtrees (root: vertex 0),\n";
+	std::cout << "                  and the largest of them.\n";
+	std::cout << "          Default: all of them.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -mode m\n";
+	std::cout << "          How the properties are computed:\n";
+	std::cout << "              separate : one call to LAL's function per property\n";
+	std::cout << "                  and tree.\n";
+	std::cout << "              fused : a single traversal per tree that computes\n";
+	std::cout << "                  the selected properties at once.\n";
+	std::cout << "              both : both of the above, comparing the time of the\n";
+	std::cout << "                  traversal with the sum of the times of the\n";
+	std::cout << "                  selected properties, and checking the results.\n";
+	std::cout << "          Default: both\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -threads P\n";
+	std::cout << "          Number of threads among which the trees are split,\n";
+	std::cout << "          for every property and for the fused traversal.\n";
+	std::cout << "          Default: 1\n";
+	std::cout << '\n';
+	generate::print_tree_shape_usage();
+	// clang-format on
+}
+
+int properties_suite_pp::parse_params() noexcept
+{
+	if (m_argc == 0) {
+		print_usage();
+		return 1;
+	}
+
+	for (uint64_t i = 0; i < m_argc; ++i) {
+		const std::string param(m_argv[i]);
+
+		if (param == "--help" or param == "-h") {
+			print_usage();
+			return 1;
+		}
+		else if (param == "-n") {
+			m_n = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_has_n = true;
+			++i;
+		}
+		else if (param == "-T") {
+			m_T = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_has_T = true;
+			++i;
+		}
+		else if (param == "-properties") {
+			m_properties.clear();
+			std::stringstream ss(m_argv[i + 1]);
+			std::string p;
+			while (std::getline(ss, p, ',')) {
+				m_properties.push_back(p);
+			}
+			++i;
+		}
+		else if (param == "-mode") {
+			m_mode = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-threads") {
+			m_threads = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			++i;
+		}
+		else if (param == "-shape") {
+			if (not generate::parse_tree_shape(m_argv[i + 1], m_shape)) {
+				std::cerr << "Error: wrong value for parameter '-shape'.\n";
+				std::cerr << "    Value: '" << m_argv[i + 1] << "'\n";
+				return 2;
+			}
+			++i;
+		}
+		else {
+			std::cerr << "Error: unrecognised option\n";
+			std::cerr << "    " << param << '\n';
+			return 2;
+		}
+	}
+	return 0;
+}
+
+int properties_suite_pp::check_errors() const noexcept
+{
+	if (not m_has_n) {
+		std::cout << "Error: missing parameter '-n'.\n";
+		return 1;
+	}
+	if (not m_has_T) {
+		std::cout << "Error: missing parameter '-T'.\n";
+		return 1;
+	}
+	if (m_n < 2) {
+		std::cout << "Error: the trees must have at least 2 vertices.\n";
+		return 1;
+	}
+	for (const std::string& p : m_properties) {
+		if (p != "mhd" and p != "diameter" and p != "caterpillar" and
+			p != "branchless" and p != "subtree") {
+			std::cout << "Error: wrong value for parameter '-properties'.\n";
+			std::cout << "    Value: '" << p << "'\n";
+			return 1;
+		}
+	}
+	if (m_mode != "separate" and m_mode != "fused" and m_mode != "both") {
+		std::cout << "Error: wrong value for parameter '-mode'.\n";
+		std::cout << "    Value: '" << m_mode << "'\n";
+		return 1;
+	}
+	if (m_threads == 0) {
+		std::cout << "Error: the number of threads must be positive.\n";
+		return 1;
+	}
+	return 0;
+}
+
+} // namespace properties_suite
+} // namespace profiling
@@ -0,0 +1,113 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// common includes
+#include "tree_shape.hpp"
+
+namespace profiling {
+namespace properties_suite {
+
+class properties_suite_pp {
+public:
+
+	properties_suite_pp(uint64_t argc, char *argv[]) noexcept;
+	~properties_suite_pp() noexcept = default;
+
+	[[nodiscard]] constexpr uint64_t get_n() const noexcept
+	{
+		return m_n;
+	}
+	[[nodiscard]] constexpr uint64_t get_T() const noexcept
+	{
+		return m_T;
+	}
+	[[nodiscard]] const std::vector<std::string>& get_properties()
+		const noexcept
+	{
+		return m_properties;
+	}
+	[[nodiscard]] const std::string& get_mode() const noexcept
+	{
+		return m_mode;
+	}
+	[[nodiscard]] constexpr uint64_t get_threads() const noexcept
+	{
+		return m_threads;
+	}
+	[[nodiscard]] const generate::tree_shape& get_shape() const noexcept
+	{
+		return m_shape;
+	}
+
+	void print_usage() const noexcept;
+
+	// returns 0 on success,
+	// returns 1 on help,
+	// returns 2 on error
+	[[nodiscard]] int parse_params() noexcept;
+
+	// returns 0 if there are no errors.
+	// returns 1 if there are errors.
+	[[nodiscard]] int check_errors() const noexcept;
+
+private:
+
+	// number of vertices
+	uint64_t m_n = 0;
+	bool m_has_n = false;
+
+	// number of trees to generate
+	uint64_t m_T = 0;
+	bool m_has_T = false;
+
+	// properties to profile
+	std::vector<std::string> m_properties{
+		"mhd", "diameter", "caterpillar", "branchless", "subtree"
+	};
+
+	// separate, fused or both
+	std::string m_mode = "both";
+
+	// number of threads every property is computed with
+	uint64_t m_threads = 1;
+
+	// shape of the trees
+	generate::tree_shape m_shape;
+
+	uint64_t m_argc;
+	char **m_argv;
+};
+
+} // namespace properties_suite
+} // namespace profiling
@@ -26,13 +26,23 @@
  ***********************************************************************/
 
 // C++ includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <random>
 
 // lal includes
+#include <lal/generate/rand_lab_free_trees.hpp>
 #include <lal/graphs/undirected_graph.hpp>
 #include <lal/properties/C_rla.hpp>
 
 // common includes
+#include "generate_complete_graphs.hpp"
+#include "generate_tree_shapes.hpp"
+#include "mapped_file.hpp"
+#include "properties_variance_C_parallel.hpp"
 #include "properties_variance_C_pp.hpp"
 #include "time.hpp"
 
@@ -57,82 +67,371 @@ void output_execution_time(
 			  << '\n';
 }
 
-} // namespace properties_variance_C
+// Adds the edges to g, shifting their vertices by 'offset'.
+void add_edges(
+	lal::graphs::undirected_graph& g,
+	const lal::edge_list& edges,
+	const uint64_t offset
+) noexcept
+{
+	for (const auto& [u, v] : edges) {
+		g.add_edge_bulk(u + offset, v + offset);
+	}
+}
 
-void properties_variance_C_graph(uint64_t argc, char *argv[]) noexcept
+// Edges of a tree of n vertices of the shape given in the parameters. Random
+// trees are uniformly random labelled trees.
+[[nodiscard]] lal::edge_list tree_edges(
+	const properties_variance_C_pp& parser,
+	const uint64_t n,
+	const uint64_t seed
+) noexcept
 {
-	properties_variance_C::properties_variance_C_pp parser(argc, argv);
-	if (parser.parse_params() > 0) {
-		return;
+	if (parser.get_shape().family == "random") {
+		lal::generate::rand_lab_free_trees Gen(n, seed);
+		return Gen.get_tree().get_edges();
 	}
-	if (parser.check_errors() > 0) {
-		return;
+	generate::tree_shape_generator<lal::graphs::free_tree> Gen(
+		n, parser.get_shape(), seed
+	);
+	return Gen.get_tree().get_edges();
+}
+
+// Builds the graph given in the parameters. Returns false on error.
+[[nodiscard]] bool make_graph(
+	const properties_variance_C_pp& parser, lal::graphs::undirected_graph& g
+) noexcept
+{
+	if (parser.get_nK() > 0) {
+		g = generate::complete_graph(parser.get_nK());
 	}
+	else if (parser.get_nKK_1() > 0) {
+		g = generate::complete_bipartite_graph(
+			parser.get_nKK_1(), parser.get_nKK_2()
+		);
+	}
+	else if (parser.has_gnp()) {
+		const uint64_t n = parser.get_gnp_n();
+		std::mt19937 gen(1234);
+		std::bernoulli_distribution d(parser.get_gnp_p());
+		g = lal::graphs::undirected_graph(n);
+		for (lal::node u = 0; u < n; ++u) {
+			for (lal::node v = u + 1; v < n; ++v) {
+				if (d(gen)) {
+					g.add_edge_bulk(u, v);
+				}
+			}
+		}
+		g.finish_bulk_add(true, false);
+	}
+	else if (parser.has_tree()) {
+		const uint64_t n = parser.get_tree_n();
+		g = lal::graphs::undirected_graph(n);
+		add_edges(g, tree_edges(parser, n, 1234), 0);
+		g.finish_bulk_add(true, false);
+	}
+	else if (parser.has_forest()) {
+		const uint64_t n = parser.get_forest_n();
+		const uint64_t k = parser.get_forest_k();
+		g = lal::graphs::undirected_graph(n);
+		uint64_t offset = 0;
+		for (uint64_t i = 0; i < k; ++i) {
+			const uint64_t size = n / k + (i < n % k ? 1 : 0);
+			add_edges(g, tree_edges(parser, size, 1234 + i), offset);
+			offset += size;
+		}
+		g.finish_bulk_add(true, false);
+	}
+	else if (parser.has_edge_list_file()) {
+		io::mapped_file file;
+		if (not file.open(parser.get_edge_list_file())) {
+			return false;
+		}
 
-	const bool reuse = parser.get_reuse();
+		lal::edge_list edges;
+		bool first = true;
+		uint64_t max = 0;
+		const bool correct = io::for_each_integer(
+			file.begin(),
+			file.end(),
+			[&](const uint64_t x)
+			{
+				if (first) {
+					edges.emplace_back(x, 0);
+				}
+				else {
+					edges.back().second = x;
+				}
+				first = not first;
+				max = std::max(max, x);
+			}
+		);
+		if (not correct or not first) {
+			std::cerr << "Error: the file '" << parser.get_edge_list_file()
+					  << "' is not a list of pairs of vertices.\n";
+			return false;
+		}
+
+		g = lal::graphs::undirected_graph(edges.empty() ? 0 : max + 1);
+		add_edges(g, edges, 0);
+		g.finish_bulk_add(true, false);
+	}
+	return true;
+}
 
+// Times LAL's var_num_crossings with the memory reuse given in the
+// parameters.
+void time_lal(
+	const properties_variance_C_pp& parser,
+	const lal::graphs::undirected_graph& g
+) noexcept
+{
+	const bool reuse = parser.get_reuse();
 	const std::size_t T = parser.get_R();
 
-	if (parser.get_nK() > 0) {
-		const uint64_t n = parser.get_nK();
+	double totallocal = 0;
+	const auto beginglobal = profiling::now();
+	for (uint64_t t = 0; t < T; ++t) {
+		const auto beginlocal = profiling::now();
+		auto res = lal::properties::var_num_crossings(g, reuse);
+		const auto endlocal = profiling::now();
+		totallocal += profiling::elapsed_time(beginlocal, endlocal);
 
-		lal::graphs::undirected_graph g(n);
-		for (lal::node u = 0; u < n; ++u) {
-			for (lal::node v = u + 1; v < n; ++v) {
-				g.add_edge(u, v);
-			}
+		if (res > 5) {
+			res += 4;
 		}
+	}
+	const auto endglobal = profiling::now();
+	const double totalglobal = profiling::elapsed_time(beginglobal, endglobal);
 
-		double totallocal = 0;
-		const auto beginglobal = profiling::now();
-		for (uint64_t t = 0; t < T; ++t) {
-			const auto beginlocal = profiling::now();
-			auto res = lal::properties::var_num_crossings(g, reuse);
-			const auto endlocal = profiling::now();
-			totallocal += profiling::elapsed_time(beginlocal, endlocal);
+	output_execution_time(totalglobal, totallocal, g.get_num_nodes(), T);
+}
 
-			if (res > 5) {
-				res += 4;
-			}
+// Compares LAL's var_num_crossings with the multithreaded evaluator for
+// 1, 2, 4, ..., P threads, with and without reusing memory.
+void time_threads(
+	const properties_variance_C_pp& parser,
+	const lal::graphs::undirected_graph& g
+) noexcept
+{
+	const uint64_t R = parser.get_R();
+	const uint64_t max_threads = parser.get_threads();
+
+	// average time of R calls, and their (common) result
+	const auto measure = [&](const auto& f, lal::numeric::rational& res)
+	{
+		const auto begin = profiling::now();
+		for (uint64_t r = 0; r < R; ++r) {
+			res = f();
 		}
-		const auto endglobal = profiling::now();
-		const double totalglobal =
-			profiling::elapsed_time(beginglobal, endglobal);
+		const auto end = profiling::now();
+		return profiling::elapsed_time(begin, end) / static_cast<double>(R);
+	};
 
-		properties_variance_C::output_execution_time(
-			totalglobal, totallocal, n, T
+	std::array<lal::numeric::rational, 2> V;
+	std::array<double, 2> base;
+	for (const bool reuse : {false, true}) {
+		base[reuse] = measure(
+			[&]()
+			{
+				return lal::properties::var_num_crossings_rational(g, reuse);
+			},
+			V[reuse]
 		);
 	}
-	if (parser.get_nKK_1() > 0) {
-		const uint64_t n1 = parser.get_nKK_1();
-		const uint64_t n2 = parser.get_nKK_2();
 
-		lal::graphs::undirected_graph g(n1 + n2);
-		for (lal::node u = 0; u < n1; ++u) {
-			for (lal::node v = 0; v < n2; ++v) {
-				g.add_edge(u, v);
+	std::cout << "Number of vertices (n)= " << g.get_num_nodes() << '\n';
+	std::cout << "Number of edges (m)= " << g.get_num_edges() << '\n';
+	std::cout << "Number of replicas (R)= " << R << '\n';
+	std::cout << "V[C]= " << V[false].to_double() << '\n';
+	std::cout << std::fixed << std::setprecision(2);
+	std::cout << std::setw(12) << "threads" << std::setw(16) << "reuse=false"
+			  << std::setw(10) << "speedup" << std::setw(16) << "reuse=true"
+			  << std::setw(10) << "speedup" << '\n';
+	std::cout << "------------------------\n";
+	std::cout << std::setw(12) << "LAL" << std::setw(16)
+			  << profiling::time_to_str(base[false]) << std::setw(10) << 1.0
+			  << std::setw(16) << profiling::time_to_str(base[true])
+			  << std::setw(10) << 1.0 << '\n';
+
+	for (uint64_t t = 1;; t = std::min(2 * t, max_threads)) {
+		std::cout << std::setw(12) << t;
+		for (const bool reuse : {false, true}) {
+			lal::numeric::rational res;
+			const double ms = measure(
+				[&]()
+				{
+					return var_num_crossings_rational(
+						g, static_cast<int>(t), reuse
+					);
+				},
+				res
+			);
+			if (res != V[reuse]) {
+				std::cerr << "\nERROR! V[C] with " << t << " threads ("
+						  << res.to_double() << ") differs from LAL's ("
+						  << V[reuse].to_double() << ").\n";
+				std::abort();
 			}
+			std::cout << std::setw(16) << profiling::time_to_str(ms)
+					  << std::setw(10) << base[reuse] / ms;
+		}
+		std::cout << '\n';
+
+		if (t == max_threads) {
+			break;
+		}
+	}
+}
+
+// Compares the exact and the floating-point evaluators of V[C] on K_n and
+// on K_{n/2,n-n/2}.
+void precision_report(const properties_variance_C_pp& parser) noexcept
+{
+	const uint64_t R = parser.get_R();
+	const int num_threads =
+		parser.has_threads() ? static_cast<int>(parser.get_threads()) : 1;
+
+	// average time of R calls, and their (common) result
+	const auto measure = [&](const auto& f, auto& res)
+	{
+		const auto begin = profiling::now();
+		for (uint64_t r = 0; r < R; ++r) {
+			res = f();
 		}
+		const auto end = profiling::now();
+		return profiling::elapsed_time(begin, end) / static_cast<double>(R);
+	};
 
-		double totallocal = 0;
-		const auto beginglobal = profiling::now();
-		for (uint64_t t = 0; t < T; ++t) {
-			const auto beginlocal = profiling::now();
-			auto res = lal::properties::var_num_crossings(g, reuse);
-			const auto endlocal = profiling::now();
-			totallocal += profiling::elapsed_time(beginlocal, endlocal);
+	const auto report = [&](const std::string& name,
+							const lal::graphs::undirected_graph& g)
+	{
+		lal::numeric::rational exact;
+		const double base = measure(
+			[&]()
+			{
+				return lal::properties::var_num_crossings_rational(g, true);
+			},
+			exact
+		);
+		const double V = exact.to_double();
+
+		std::cout << "------------------------\n";
+		std::cout << "Graph: " << name << '\n';
+		std::cout << "V[C]= " << std::setprecision(17) << V << '\n';
+		std::cout << std::setw(20) << "method" << std::setw(16) << "time"
+				  << std::setw(10) << "speedup" << std::setw(14) << "abs error"
+				  << std::setw(14) << "rel error" << '\n';
 
-			if (res > 5) {
-				res += 4;
+		const auto print_row =
+			[&](const std::string& method, const double ms, const double x)
+		{
+			const double abs_err = std::abs(x - V);
+			std::cout << std::setw(20) << method << std::setw(16)
+					  << profiling::time_to_str(ms) << std::fixed
+					  << std::setprecision(2) << std::setw(10) << base / ms
+					  << std::scientific << std::setprecision(3)
+					  << std::setw(14) << abs_err;
+			if (V != 0) {
+				std::cout << std::setw(14) << abs_err / std::abs(V);
+			}
+			else {
+				std::cout << std::setw(14) << "-";
 			}
+			std::cout << std::defaultfloat << '\n';
+		};
+		const auto check_exact =
+			[&](const std::string& method, const lal::numeric::rational& x)
+		{
+			if (x != exact) {
+				std::cerr << "ERROR! Method '" << method
+						  << "' is not exact.\n";
+				std::abort();
+			}
+		};
+
+		print_row("LAL rational", base, V);
+
+		double d;
+		double ms = measure(
+			[&]()
+			{
+				return lal::properties::var_num_crossings(g, true);
+			},
+			d
+		);
+		print_row("LAL double", ms, d);
+
+		const std::vector<std::pair<std::string, accumulation>> exact_accs = {
+			{"integer", accumulation::integer}, {"int128", accumulation::int128}
+		};
+		for (const auto& [method, acc] : exact_accs) {
+			lal::numeric::rational x;
+			ms = measure(
+				[&]()
+				{
+					return var_num_crossings_rational(
+						g, num_threads, true, acc
+					);
+				},
+				x
+			);
+			check_exact(method, x);
+			print_row(method, ms, x.to_double());
 		}
-		const auto endglobal = profiling::now();
-		const double totalglobal =
-			profiling::elapsed_time(beginglobal, endglobal);
 
-		properties_variance_C::output_execution_time(
-			totalglobal, totallocal, n1 + n2, T
+		ms = measure(
+			[&]()
+			{
+				return var_num_crossings(g, num_threads, true);
+			},
+			d
 		);
+		print_row("double", ms, d);
+	};
+
+	std::cout << "Number of replicas (R)= " << R << '\n';
+	std::cout << "Threads of the evaluators of the profiler: " << num_threads
+			  << '\n';
+	for (const uint64_t n : parser.get_precision_sizes()) {
+		report("K_" + std::to_string(n), generate::complete_graph(n));
+
+		const uint64_t n1 = n / 2;
+		const uint64_t n2 = n - n1;
+		report(
+			"K_{" + std::to_string(n1) + "," + std::to_string(n2) + "}",
+			generate::complete_bipartite_graph(n1, n2)
+		);
+	}
+}
+
+} // namespace properties_variance_C
+
+void properties_variance_C_graph(uint64_t argc, char *argv[]) noexcept
+{
+	properties_variance_C::properties_variance_C_pp parser(argc, argv);
+	if (parser.parse_params() > 0) {
+		return;
+	}
+	if (parser.check_errors() > 0) {
+		return;
+	}
+
+	if (parser.has_precision()) {
+		properties_variance_C::precision_report(parser);
+		return;
+	}
+
+	lal::graphs::undirected_graph g;
+	if (not properties_variance_C::make_graph(parser, g)) {
+		return;
+	}
+
+	if (parser.has_threads()) {
+		properties_variance_C::time_threads(parser, g);
+	}
+	else {
+		properties_variance_C::time_lal(parser, g);
 	}
 }
 
@@ -0,0 +1,450 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "properties_variance_C_parallel.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// common includes
+#include "csr_graph.hpp"
+
+namespace profiling {
+namespace properties_variance_C {
+
+namespace {
+
+__extension__ typedef __int128 int128_t;
+
+// Common denominator of the closed form.
+static constexpr int64_t denominator = 180;
+
+/*
+ * Sums over the vertices, the edges, the triangles and the 4-cycles of a
+ * graph, from which the number of subgraphs of every kind in the closed form
+ * is obtained. Here, k_u is the degree of vertex u and s_u is the sum of the
+ * degrees of the neighbours of u. All the terms are non-negative.
+ */
+template <typename T>
+struct graph_sums {
+	// sum of C(k_u,2): the number of paths of length 2
+	T paths_2 = 0;
+	// sum of C(k_u,3): the number of stars of 3 leaves
+	T stars_3 = 0;
+	// sum of C(k_u,4): the number of stars of 4 leaves
+	T stars_4 = 0;
+	// sum of k_u*C(k_u,2)
+	T k_paths_2 = 0;
+	// sum of (k_u - 1)*s_u
+	T k_s = 0;
+	// sum of (s_u - k_u)^2
+	T s_k_squared = 0;
+	// sum of k_u*(k_u - 1)^2
+	T k_k_squared = 0;
+	// sum of C(k_u - 1,2)*(s_u - k_u)
+	T forks_s = 0;
+	// sum of (k_u - 1)*(k_v - 1) over all edges uv
+	T edge_k_k = 0;
+	// sum of (k_u + k_v)*(k_u - 1)*(k_v - 1) + (s_u - k_v)*(k_v - 1) +
+	// (s_v - k_u)*(k_u - 1) over all edges uv
+	T edge_paths_3 = 0;
+	// number of triangles
+	T triangles = 0;
+	// sum of k_u + k_v + k_w over all triangles uvw
+	T triangle_degrees = 0;
+	// number of 4-cycles
+	T cycles_4 = 0;
+
+	graph_sums& operator+= (const graph_sums& S) noexcept
+	{
+		paths_2 += S.paths_2;
+		stars_3 += S.stars_3;
+		stars_4 += S.stars_4;
+		k_paths_2 += S.k_paths_2;
+		k_s += S.k_s;
+		s_k_squared += S.s_k_squared;
+		k_k_squared += S.k_k_squared;
+		forks_s += S.forks_s;
+		edge_k_k += S.edge_k_k;
+		edge_paths_3 += S.edge_paths_3;
+		triangles += S.triangles;
+		triangle_degrees += S.triangle_degrees;
+		cycles_4 += S.cycles_4;
+		return *this;
+	}
+};
+
+template <typename T>
+[[nodiscard]] T choose_2(const T& x) noexcept
+{
+	return x * (x - 1) / 2;
+}
+
+template <typename T>
+[[nodiscard]] T choose_3(const T& x) noexcept
+{
+	return x * (x - 1) * (x - 2) / 6;
+}
+
+/*
+ * The sums of the graph with adjacency lists 'A'. The vertices are split
+ * among the threads; every thread adds up its terms in a value of type T, and
+ * the partial sums are added at the end. The triangles and 4-cycles found
+ * through every neighbour of a vertex are counted in 64 bits, which cannot
+ * overflow for degrees below 2^31, and added to the sums once per neighbour.
+ *
+ * Triangles and 4-cycles are counted once, from their vertex of highest
+ * rank, where vertices are ranked by degree and then by label: a 4-cycle
+ * u-v-w-x-u where u has the highest rank is found as two paths u-v-w and
+ * u-x-w, which only visit the neighbours of vertices of lower rank than u.
+ * With 'reuse', every thread counts these paths in an array of n counters
+ * allocated once; otherwise, every vertex counts them in a hash table of its
+ * own.
+ */
+template <typename T>
+[[nodiscard]] graph_sums<T> make_sums(
+	const graphs::csr_adjacency& A, const int num_threads, const bool reuse
+) noexcept
+{
+	const uint64_t n = A.num_nodes();
+
+	std::vector<uint64_t> s(n, 0);
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+	for (lal::node u = 0; u < n; ++u) {
+		for (const lal::node w : A.neighbors(u)) {
+			s[u] += A.degree(w);
+		}
+	}
+
+	// rank of every vertex
+	std::vector<lal::node> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(
+		order.begin(),
+		order.end(),
+		[&](const lal::node v, const lal::node u)
+		{
+			return A.degree(v) < A.degree(u) or
+				   (A.degree(v) == A.degree(u) and v < u);
+		}
+	);
+	std::vector<uint64_t> rank(n);
+	for (uint64_t r = 0; r < n; ++r) {
+		rank[order[r]] = r;
+	}
+
+	// whether v has lower rank than u
+	const auto lower = [&](const lal::node v, const lal::node u) -> bool
+	{
+		return rank[v] < rank[u];
+	};
+
+	graph_sums<T> total;
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		graph_sums<T> partial;
+
+		// with 'reuse': number of paths u-v-w, the vertices w with at least
+		// one, and mark[w] = u + 1 when w is a neighbour of u of lower rank
+		std::vector<uint64_t> paths(reuse ? n : 0, 0);
+		std::vector<lal::node> ends;
+		std::vector<uint64_t> mark(reuse ? n : 0, 0);
+
+#pragma omp for schedule(dynamic, 64)
+		for (lal::node u = 0; u < n; ++u) {
+			const T k = static_cast<T>(A.degree(u));
+			const T sk = static_cast<T>(s[u] - A.degree(u));
+
+			partial.paths_2 += choose_2(k);
+			partial.stars_3 += choose_3(k);
+			partial.stars_4 += choose_3(k) * (k - 3) / 4;
+			partial.k_paths_2 += k * choose_2(k);
+			partial.k_s += (k - 1) * static_cast<T>(s[u]);
+			partial.s_k_squared += sk * sk;
+			partial.k_k_squared += k * (k - 1) * (k - 1);
+			partial.forks_s += choose_2(k - 1) * sk;
+
+			for (const lal::node v : A.neighbors(u)) {
+				if (v < u) {
+					continue;
+				}
+				const T kv = static_cast<T>(A.degree(v));
+				const T svk = static_cast<T>(s[v] - A.degree(u));
+				const T suk = static_cast<T>(s[u] - A.degree(v));
+				partial.edge_k_k += (k - 1) * (kv - 1);
+				partial.edge_paths_3 += (k + kv) * (k - 1) * (kv - 1) +
+										suk * (kv - 1) + svk * (k - 1);
+			}
+
+			// triangles and 4-cycles where u has the highest rank
+			uint64_t cycles = 0;
+			uint64_t triangles = 0;
+			uint64_t degrees_w = 0;
+			// adds the cycles found through the neighbour v of u
+			const auto add_cycles = [&](const lal::node v)
+			{
+				partial.cycles_4 += static_cast<T>(cycles);
+				partial.triangles += static_cast<T>(triangles);
+				partial.triangle_degrees += static_cast<T>(
+					triangles * (A.degree(u) + A.degree(v)) + degrees_w
+				);
+				cycles = triangles = degrees_w = 0;
+			};
+
+			if (reuse) {
+				for (const lal::node v : A.neighbors(u)) {
+					if (lower(v, u)) {
+						mark[v] = u + 1;
+					}
+				}
+				for (const lal::node v : A.neighbors(u)) {
+					if (not lower(v, u)) {
+						continue;
+					}
+					for (const lal::node w : A.neighbors(v)) {
+						if (not lower(w, u)) {
+							continue;
+						}
+						cycles += paths[w];
+						if (paths[w]++ == 0) {
+							ends.push_back(w);
+						}
+						if (lower(w, v) and mark[w] == u + 1) {
+							++triangles;
+							degrees_w += A.degree(w);
+						}
+					}
+					add_cycles(v);
+				}
+				for (const lal::node w : ends) {
+					paths[w] = 0;
+				}
+				ends.clear();
+			}
+			else {
+				// memory is not reused across vertices
+				std::unordered_map<lal::node, uint64_t> paths_to;
+				for (const lal::node v : A.neighbors(u)) {
+					if (not lower(v, u)) {
+						continue;
+					}
+					for (const lal::node w : A.neighbors(v)) {
+						if (not lower(w, u)) {
+							continue;
+						}
+						cycles += paths_to[w]++;
+						if (lower(w, v) and A.contains(u, w)) {
+							++triangles;
+							degrees_w += A.degree(w);
+						}
+					}
+					add_cycles(v);
+				}
+			}
+		}
+
+#pragma omp critical
+		total += partial;
+	}
+
+	return total;
+}
+
+/*
+ * 180*V[C] of a graph with m edges and sums 'S'. V[C] is the sum of
+ * Cov(X_q, X_r) over all pairs (q,r) of elements of Q, which only depends on
+ * the subgraph formed by the (at most) four edges of q and r, and
+ *
+ *     180*V[C] = 40*n(2K2) + 24*n(3K2) + 20*n(P3 + K2) - 4*n(P4 + K2)
+ *                + 4*n(2P3) - 14*n(P5) - 40*n(C4),
+ *
+ * where n(H) is the number of subgraphs isomorphic to H, K2 is an edge, Pk
+ * is a path of k vertices, C4 is a 4-cycle, and kH and H + H' are disjoint
+ * unions. The number of each of these subgraphs follows from the sums by
+ * inclusion-exclusion.
+ */
+template <typename T>
+[[nodiscard]] T closed_form(const uint64_t m, const graph_sums<T>& S) noexcept
+{
+	const T M = static_cast<T>(m);
+
+	// subgraphs of three edges
+	const T paths_3 = S.edge_k_k - S.triangles * 3;
+	const T paths_2_edge =
+		S.paths_2 * (M + 2) - (S.k_paths_2 + S.k_s) + S.triangles * 3;
+	const T edges_3 =
+		choose_3(M) - paths_2_edge - paths_3 - S.stars_3 - S.triangles;
+
+	// subgraphs of four edges
+	const T paths_3_edge = paths_3 * (M + 3) + S.triangle_degrees * 6 -
+						   S.triangles * 12 + S.cycles_4 * 4 - S.edge_paths_3;
+	const T paths_4_x2 = S.s_k_squared - S.k_k_squared -
+						 S.triangle_degrees * 4 + S.triangles * 18 -
+						 S.cycles_4 * 8;
+	const T paws = S.triangle_degrees - S.triangles * 6;
+	const T forks = S.forks_s - S.triangle_degrees * 2 + S.triangles * 12;
+	// n(2P3) + n(P5): the pairs of paths of length 2 without common edges
+	// that do not form any other subgraph
+	const T paths_2_paths_2 = choose_2(S.paths_2) - paths_3 - S.stars_3 * 3 -
+							  S.triangles * 3 - S.cycles_4 * 2 - paws * 2 -
+							  S.stars_4 * 3 - forks;
+
+	const T Q = choose_2(M) - S.paths_2;
+	return Q * 40 + edges_3 * 24 + paths_2_edge * 20 - paths_3_edge * 4 +
+		   paths_2_paths_2 * 4 - paths_4_x2 * 7 - S.cycles_4 * 40;
+}
+
+// Builds sorted adjacency lists, for the degrees and the adjacency queries.
+void build_adjacency(
+	const uint64_t n, const lal::edge_list& edges, graphs::csr_adjacency& A
+) noexcept
+{
+	std::vector<lal::neighbourhood> lists(n);
+	for (const auto& [u, v] : edges) {
+		lists[u].push_back(v);
+		lists[v].push_back(u);
+	}
+	A.build(
+		n,
+		[&](const lal::node u) -> const lal::neighbourhood&
+		{
+			return lists[u];
+		}
+	);
+}
+
+[[nodiscard]] lal::numeric::integer to_integer(int128_t x) noexcept
+{
+	if (x == 0) {
+		return lal::numeric::integer(0);
+	}
+	const bool negative = x < 0;
+	std::string digits;
+	while (x != 0) {
+		const int128_t d = x % 10;
+		digits.push_back(static_cast<char>('0' + (d < 0 ? -d : d)));
+		x /= 10;
+	}
+	if (negative) {
+		digits.push_back('-');
+	}
+	std::reverse(digits.begin(), digits.end());
+	return lal::numeric::integer(digits);
+}
+
+} // namespace
+
+bool fits_int128(const uint64_t n, const lal::edge_list& edges) noexcept
+{
+	std::vector<uint64_t> degree(n, 0);
+	for (const auto& [u, v] : edges) {
+		++degree[u];
+		++degree[v];
+	}
+	const double m = static_cast<double>(edges.size());
+	const double D = static_cast<double>(
+		degree.empty() ? 0 : *std::max_element(degree.begin(), degree.end())
+	);
+
+	// every sum of graph_sums is at most 4*m*D^3 <= 4*X^2, since D <= m,
+	// every term of the closed form is at most 4*X^2 or m^3, and they are
+	// added with coefficients of at most 40
+	const double X = m * (D + 1);
+	const double bound = (X * X + m * m * m) * 256;
+	return bound < std::ldexp(1.0, 120);
+}
+
+lal::numeric::rational var_num_crossings_rational(
+	const uint64_t n,
+	const lal::edge_list& edges,
+	const int num_threads,
+	const bool reuse,
+	const accumulation acc
+) noexcept
+{
+	graphs::csr_adjacency A;
+	build_adjacency(n, edges, A);
+
+	lal::numeric::integer total;
+	if (acc == accumulation::int128 and fits_int128(n, edges)) {
+		const graph_sums<int128_t> S =
+			make_sums<int128_t>(A, num_threads, reuse);
+		total = to_integer(closed_form(edges.size(), S));
+	}
+	else {
+		const graph_sums<lal::numeric::integer> S =
+			make_sums<lal::numeric::integer>(A, num_threads, reuse);
+		total = closed_form(edges.size(), S);
+	}
+	return lal::numeric::rational(total, lal::numeric::integer(denominator));
+}
+
+double var_num_crossings(
+	const uint64_t n,
+	const lal::edge_list& edges,
+	const int num_threads,
+	const bool reuse
+) noexcept
+{
+	graphs::csr_adjacency A;
+	build_adjacency(n, edges, A);
+
+	const graph_sums<double> S = make_sums<double>(A, num_threads, reuse);
+	return closed_form(edges.size(), S) / static_cast<double>(denominator);
+}
+
+lal::numeric::rational var_num_crossings_rational(
+	const lal::graphs::undirected_graph& g,
+	const int num_threads,
+	const bool reuse,
+	const accumulation acc
+) noexcept
+{
+	return var_num_crossings_rational(
+		g.get_num_nodes(), g.get_edges(), num_threads, reuse, acc
+	);
+}
+
+double var_num_crossings(
+	const lal::graphs::undirected_graph& g,
+	const int num_threads,
+	const bool reuse
+) noexcept
+{
+	return var_num_crossings(
+		g.get_num_nodes(), g.get_edges(), num_threads, reuse
+	);
+}
+
+} // namespace properties_variance_C
+} // namespace profiling
@@ -0,0 +1,110 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+
+// lal includes
+#include <lal/basic_types.hpp>
+#include <lal/graphs/undirected_graph.hpp>
+#include <lal/numeric/rational.hpp>
+
+namespace profiling {
+namespace properties_variance_C {
+
+/*
+ * Exact variance of the number of crossings C in uniformly random linear
+ * arrangements, computed with several threads.
+ *
+ * V[C] is the sum of Cov(X_q, X_r) over all pairs (q,r) of elements of Q,
+ * where X_q indicates that the two edges of q cross. The covariance only
+ * depends on the subgraph formed by the edges of q and r, so V[C] is a
+ * linear combination of the number of subgraphs of a few kinds (pairs and
+ * triples of independent edges, paths, 4-cycles, ...). These numbers follow
+ * from sums over the vertices, the edges, the triangles and the 4-cycles of
+ * the graph, which are split among the threads vertex by vertex; no element
+ * of Q is enumerated. The result does not depend on the number of threads.
+ *
+ * With 'reuse', every thread allocates its memory once; otherwise, memory
+ * is allocated for every vertex, as in LAL's non-reusing path.
+ *
+ * The exact evaluator does all the arithmetic, from the sums to the closed
+ * form, either in lal::numeric::integer or in 128-bit integers; the latter
+ * only when a bound on the degrees shows that nothing can overflow. The
+ * floating point evaluator does all the arithmetic in double precision.
+ */
+
+// The arithmetic of the exact evaluator.
+enum class accumulation {
+	// in lal::numeric::integer
+	integer,
+	// in 128-bit integers, when neither the sums nor the closed form can
+	// overflow; otherwise, as in 'integer'
+	int128
+};
+
+// Whether neither the sums nor the closed form of V[C] of the graph with n
+// vertices and edges 'edges' can overflow a 128-bit integer.
+[[nodiscard]] bool fits_int128(const uint64_t n, const lal::edge_list& edges)
+	noexcept;
+
+// V[C] of the graph with n vertices and edges 'edges', exactly.
+[[nodiscard]] lal::numeric::rational var_num_crossings_rational(
+	const uint64_t n,
+	const lal::edge_list& edges,
+	const int num_threads,
+	const bool reuse,
+	const accumulation acc = accumulation::int128
+) noexcept;
+
+// V[C] of the graph with n vertices and edges 'edges', in double precision.
+[[nodiscard]] double var_num_crossings(
+	const uint64_t n,
+	const lal::edge_list& edges,
+	const int num_threads,
+	const bool reuse
+) noexcept;
+
+// V[C] of an undirected graph, exactly.
+[[nodiscard]] lal::numeric::rational var_num_crossings_rational(
+	const lal::graphs::undirected_graph& g,
+	const int num_threads,
+	const bool reuse,
+	const accumulation acc = accumulation::int128
+) noexcept;
+
+// V[C] of an undirected graph, in double precision.
+[[nodiscard]] double var_num_crossings(
+	const lal::graphs::undirected_graph& g,
+	const int num_threads,
+	const bool reuse
+) noexcept;
+
+} // namespace properties_variance_C
+} // namespace profiling
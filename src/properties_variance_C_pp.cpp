@@ -30,6 +30,7 @@
 // C++ includes
 #include <cstdlib>
 #include <iostream>
+#include <sstream>
 
 namespace profiling {
 namespace properties_variance_C {
@@ -51,16 +52,50 @@ void properties_variance_C_pp::print_usage() const noexcept
 	std::cout << "    Those marked with [i] are mandatory for execution mode i.\n";
 	std::cout << "    Those marked with [?] are optional.\n";
 	std::cout << '\n';
+	std::cout << "    Exactly one of the options marked with [*] must be given.\n";
+	std::cout << '\n';
 	std::cout << "    [*]   -nK n\n";
 	std::cout << "          Indicate the number of vertices of the complete graph.\n";
 	std::cout << '\n';
 	std::cout << "    [*]   -nKK n1 n2\n";
 	std::cout << "          Indicate the number of vertices of the complete bipartite graph.\n";
 	std::cout << '\n';
+	std::cout << "    [*]   -gnp n p\n";
+	std::cout << "          Erdos-Renyi graph with n vertices where every edge exists\n";
+	std::cout << "          with probability p.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -tree n\n";
+	std::cout << "          Uniformly random labelled free tree of n vertices, or\n";
+	std::cout << "          a tree of the shape given with -shape.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -forest n k\n";
+	std::cout << "          Forest of k uniformly random labelled free trees (or\n";
+	std::cout << "          trees of the shape given with -shape) with n vertices\n";
+	std::cout << "          in total, split as evenly as possible.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -el-file f\n";
+	std::cout << "          File with the edge list of the graph: the vertices\n";
+	std::cout << "          u_1 v_1 ... u_k v_k separated by whitespace.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -precision n_1,n_2,...,n_k\n";
+	std::cout << "          Compare the exact and the floating-point evaluators of\n";
+	std::cout << "          V[C] on K_n and on K_{n/2,n-n/2} for every given n:\n";
+	std::cout << "          LAL's rational and double functions, and the exact\n";
+	std::cout << "          (lal::numeric::integer and 128-bit) and double\n";
+	std::cout << "          accumulations of the evaluator of the profiler. Reports\n";
+	std::cout << "          the time, the speedup over LAL's rational function, and\n";
+	std::cout << "          the absolute and relative errors.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -threads P\n";
+	std::cout << "          Compare LAL's var_num_crossings with a multithreaded\n";
+	std::cout << "          exact evaluator run with 1, 2, 4, ..., P threads, with\n";
+	std::cout << "          and without reusing memory. '-reuse' is ignored.\n";
+	std::cout << '\n';
 	std::cout << "    [?]   -R number of replicas\n";
 	std::cout << '\n';
 	std::cout << "    [?]   -reuse Reuse memory? true/false\n";
 	std::cout << '\n';
+	generate::print_tree_shape_usage();
 	// clang-format on
 }
 
@@ -103,6 +138,53 @@ int properties_variance_C_pp::parse_params() noexcept
 			m_has_n_KK = true;
 			i += 2;
 		}
+		else if (param == "-gnp") {
+			m_gnp_n = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_gnp_p = atof(m_argv[i + 2]);
+			m_has_gnp = true;
+			i += 2;
+		}
+		else if (param == "-tree") {
+			m_tree_n = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_has_tree = true;
+			++i;
+		}
+		else if (param == "-forest") {
+			m_forest_n = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_forest_k = static_cast<uint64_t>(atoi(m_argv[i + 2]));
+			m_has_forest = true;
+			i += 2;
+		}
+		else if (param == "-el-file") {
+			m_el_file = std::string(m_argv[i + 1]);
+			m_has_el_file = true;
+			++i;
+		}
+		else if (param == "-precision") {
+			m_precision_sizes.clear();
+			std::stringstream ss(m_argv[i + 1]);
+			std::string n;
+			while (std::getline(ss, n, ',')) {
+				m_precision_sizes.push_back(
+					static_cast<uint64_t>(atoll(n.c_str()))
+				);
+			}
+			m_has_precision = true;
+			++i;
+		}
+		else if (param == "-threads") {
+			m_threads = static_cast<uint64_t>(atoi(m_argv[i + 1]));
+			m_has_threads = true;
+			++i;
+		}
+		else if (param == "-shape") {
+			if (not generate::parse_tree_shape(m_argv[i + 1], m_shape)) {
+				std::cerr << "Error: wrong value for parameter '-shape'.\n";
+				std::cerr << "    Value: '" << m_argv[i + 1] << "'\n";
+				return 2;
+			}
+			++i;
+		}
 		else {
 			std::cerr << "Error: unrecognised option\n";
 			std::cerr << "    " << param << '\n';
@@ -114,14 +196,31 @@ int properties_variance_C_pp::parse_params() noexcept
 
 int properties_variance_C_pp::check_errors() const noexcept
 {
-	if (not m_has_n_K and not m_has_n_KK) {
+	const int num_graphs = m_has_n_K + m_has_n_KK + m_has_gnp + m_has_tree +
+						   m_has_forest + m_has_el_file + m_has_precision;
+	if (num_graphs == 0) {
 		std::cout << "Error: missing parameter.\n";
-		std::cout << "    Use either -nK or -nKK.\n";
+		std::cout << "    Use one of -nK, -nKK, -gnp, -tree, -forest,\n";
+		std::cout << "    -el-file, -precision.\n";
 		return 1;
 	}
-	if (m_has_n_K and m_has_n_KK) {
+	if (num_graphs > 1) {
 		std::cout << "Error: too many parameters.\n";
-		std::cout << "    Use only one of -nK or -nKK.\n";
+		std::cout << "    Use only one of -nK, -nKK, -gnp, -tree, -forest,\n";
+		std::cout << "    -el-file, -precision.\n";
+		return 1;
+	}
+	if (m_has_gnp and (m_gnp_p < 0 or m_gnp_p > 1)) {
+		std::cout << "Error: the probability of -gnp must be in [0,1].\n";
+		return 1;
+	}
+	if (m_has_forest and (m_forest_k == 0 or m_forest_k > m_forest_n)) {
+		std::cout << "Error: the number of trees of -forest must be in\n";
+		std::cout << "    [1,n].\n";
+		return 1;
+	}
+	if (m_has_threads and m_threads == 0) {
+		std::cout << "Error: the number of threads must be positive.\n";
 		return 1;
 	}
 	return 0;
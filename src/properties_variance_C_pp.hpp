@@ -29,6 +29,11 @@
 
 // C++ includes
 #include <cstdint>
+#include <string>
+#include <vector>
+
+// common includes
+#include "tree_shape.hpp"
 
 namespace profiling {
 namespace properties_variance_C {
@@ -59,6 +64,67 @@ public:
 	{
 		return m_reuse;
 	}
+	[[nodiscard]] bool has_gnp() const noexcept
+	{
+		return m_has_gnp;
+	}
+	[[nodiscard]] uint64_t get_gnp_n() const noexcept
+	{
+		return m_gnp_n;
+	}
+	[[nodiscard]] double get_gnp_p() const noexcept
+	{
+		return m_gnp_p;
+	}
+	[[nodiscard]] bool has_tree() const noexcept
+	{
+		return m_has_tree;
+	}
+	[[nodiscard]] uint64_t get_tree_n() const noexcept
+	{
+		return m_tree_n;
+	}
+	[[nodiscard]] bool has_forest() const noexcept
+	{
+		return m_has_forest;
+	}
+	[[nodiscard]] uint64_t get_forest_n() const noexcept
+	{
+		return m_forest_n;
+	}
+	[[nodiscard]] uint64_t get_forest_k() const noexcept
+	{
+		return m_forest_k;
+	}
+	[[nodiscard]] bool has_edge_list_file() const noexcept
+	{
+		return m_has_el_file;
+	}
+	[[nodiscard]] const std::string& get_edge_list_file() const noexcept
+	{
+		return m_el_file;
+	}
+	[[nodiscard]] bool has_precision() const noexcept
+	{
+		return m_has_precision;
+	}
+	[[nodiscard]] const std::vector<uint64_t>&
+	get_precision_sizes() const noexcept
+	{
+		return m_precision_sizes;
+	}
+	[[nodiscard]] bool has_threads() const noexcept
+	{
+		return m_has_threads;
+	}
+	[[nodiscard]] uint64_t get_threads() const noexcept
+	{
+		return m_threads;
+	}
+	[[nodiscard]] const generate::tree_shape& get_shape() const noexcept
+	{
+		return m_shape;
+	}
 
 	void print_usage() const noexcept;
 
@@ -88,6 +154,35 @@ private:
 	uint64_t m_n_KK_2 = 0;
 	bool m_has_n_KK = false;
 
+	// Erdos-Renyi graph G(n,p)
+	uint64_t m_gnp_n = 0;
+	double m_gnp_p = 0;
+	bool m_has_gnp = false;
+
+	// size of the random labelled free tree
+	uint64_t m_tree_n = 0;
+	bool m_has_tree = false;
+
+	// size and number of trees of the random forest
+	uint64_t m_forest_n = 0;
+	uint64_t m_forest_k = 0;
+	bool m_has_forest = false;
+
+	// file with the edge list of the graph
+	std::string m_el_file;
+	bool m_has_el_file = false;
+
+	// sizes of the graphs of the precision report
+	std::vector<uint64_t> m_precision_sizes;
+	bool m_has_precision = false;
+
+	// maximum number of threads of the parallel evaluator
+	uint64_t m_threads = 0;
+	bool m_has_threads = false;
+
+	// shape of the trees
+	generate::tree_shape m_shape;
+
 	uint64_t m_argc;
 	char **m_argv;
 };
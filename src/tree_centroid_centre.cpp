@@ -0,0 +1,161 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "tree_centroid_centre.hpp"
+
+// C++ includes
+#include <algorithm>
+
+namespace profiling {
+namespace properties_centroid_centre {
+
+void workspace::reserve(const uint64_t n) noexcept
+{
+	if (m_order.size() < n) {
+		m_order.resize(n);
+		m_parent.resize(n);
+		m_size.resize(n);
+		m_largest.resize(n);
+	}
+}
+
+std::pair<lal::node, lal::node>
+workspace::centroid(const lal::graphs::free_tree& t) noexcept
+{
+	const uint64_t n = t.get_num_nodes();
+	if (n <= 1) {
+		return {0, n};
+	}
+	reserve(n);
+
+	// BFS from vertex 0
+	std::size_t head = 0;
+	std::size_t tail = 0;
+	m_order[tail++] = 0;
+	m_parent[0] = n;
+	while (head < tail) {
+		const lal::node u = m_order[head++];
+		for (const lal::node v : t.get_neighbors(u)) {
+			if (v != m_parent[u]) {
+				m_parent[v] = u;
+				m_order[tail++] = v;
+			}
+		}
+	}
+
+	// subtree sizes, from the leaves up
+	for (std::size_t i = 0; i < n; ++i) {
+		m_size[i] = 1;
+		m_largest[i] = 0;
+	}
+	for (std::size_t i = n - 1; i > 0; --i) {
+		const lal::node v = m_order[i];
+		const lal::node p = m_parent[v];
+		m_size[p] += m_size[v];
+		m_largest[p] = std::max(m_largest[p], m_size[v]);
+	}
+
+	// a vertex is centroidal when no component of the tree without it has
+	// more than n/2 vertices
+	std::pair<lal::node, lal::node> res = {n, n};
+	for (lal::node u = 0; u < n; ++u) {
+		if (std::max(m_largest[u], n - m_size[u]) <= n / 2) {
+			if (res.first == n) {
+				res.first = u;
+			}
+			else {
+				res.second = u;
+				break;
+			}
+		}
+	}
+	return res;
+}
+
+std::pair<lal::node, lal::node>
+workspace::centre(const lal::graphs::free_tree& t) noexcept
+{
+	const uint64_t n = t.get_num_nodes();
+	if (n <= 1) {
+		return {0, n};
+	}
+	reserve(n);
+
+	// peel the leaves layer by layer until one or two vertices remain
+	std::size_t tail = 0;
+	for (lal::node u = 0; u < n; ++u) {
+		m_size[u] = t.get_degree(u);
+		if (m_size[u] == 1) {
+			m_order[tail++] = u;
+		}
+	}
+
+	std::size_t head = 0;
+	uint64_t remaining = n;
+	while (remaining > 2) {
+		const std::size_t layer_end = tail;
+		remaining -= layer_end - head;
+		for (; head < layer_end; ++head) {
+			const lal::node u = m_order[head];
+			m_size[u] = 0;
+			for (const lal::node v : t.get_neighbors(u)) {
+				if (m_size[v] > 0 and --m_size[v] == 1) {
+					m_order[tail++] = v;
+				}
+			}
+		}
+	}
+
+	// the last layer holds the central vertices
+	if (tail - head == 1) {
+		return {m_order[head], n};
+	}
+	return std::minmax(m_order[head], m_order[head + 1]);
+}
+
+void workspace::centroid(
+	const std::span<const lal::graphs::free_tree> trees,
+	const std::span<std::pair<lal::node, lal::node>> out
+) noexcept
+{
+	for (std::size_t i = 0; i < trees.size(); ++i) {
+		out[i] = centroid(trees[i]);
+	}
+}
+
+void workspace::centre(
+	const std::span<const lal::graphs::free_tree> trees,
+	const std::span<std::pair<lal::node, lal::node>> out
+) noexcept
+{
+	for (std::size_t i = 0; i < trees.size(); ++i) {
+		out[i] = centre(trees[i]);
+	}
+}
+
+} // namespace properties_centroid_centre
+} // namespace profiling
@@ -0,0 +1,93 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+// lal includes
+#include <lal/basic_types.hpp>
+#include <lal/graphs/free_tree.hpp>
+
+namespace profiling {
+namespace properties_centroid_centre {
+
+/*
+ * Centroid and centre of free trees with buffers kept across calls.
+ *
+ * The buffers (BFS order, parents, subtree sizes and degrees) grow to the
+ * size of the largest tree seen and are never released, so computing the
+ * centroid or the centre of many small trees allocates nothing after the
+ * first call.
+ *
+ * As in lal::properties::tree_centroid and tree_centre, the result is a
+ * pair of vertices; when there is only one centroidal (or central) vertex,
+ * the second element is the number of vertices of the tree. The empty tree
+ * touches no buffer, and both elements of its result are 0.
+ */
+class workspace {
+public:
+
+	[[nodiscard]] std::pair<lal::node, lal::node>
+	centroid(const lal::graphs::free_tree& t) noexcept;
+
+	[[nodiscard]] std::pair<lal::node, lal::node>
+	centre(const lal::graphs::free_tree& t) noexcept;
+
+	// Writes the centroid of trees[i] into out[i].
+	void centroid(
+		const std::span<const lal::graphs::free_tree> trees,
+		const std::span<std::pair<lal::node, lal::node>> out
+	) noexcept;
+
+	// Writes the centre of trees[i] into out[i].
+	void centre(
+		const std::span<const lal::graphs::free_tree> trees,
+		const std::span<std::pair<lal::node, lal::node>> out
+	) noexcept;
+
+private:
+
+	// Makes all buffers at least n elements long.
+	void reserve(const uint64_t n) noexcept;
+
+	// vertices in BFS order from vertex 0, or leaves in peeling order
+	std::vector<lal::node> m_order;
+	// parent of every vertex in the BFS
+	std::vector<lal::node> m_parent;
+	// size of the subtree of every vertex, or the remaining degree
+	std::vector<uint64_t> m_size;
+	// size of the largest subtree hanging from every vertex
+	std::vector<uint64_t> m_largest;
+};
+
+} // namespace properties_centroid_centre
+} // namespace profiling
@@ -0,0 +1,216 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// lal includes
+#include <lal/graphs/free_tree.hpp>
+#include <lal/graphs/rooted_tree.hpp>
+
+namespace profiling {
+namespace tree_isomorphism {
+
+// Fingerprint of a tree. Isomorphic trees have equal fingerprints, so trees
+// with different fingerprints are not isomorphic.
+struct fingerprint {
+	// hash of the AHU canonical form of the tree, rooted at its root (rooted
+	// trees) or at its centre (free trees)
+	uint64_t ahu = 0;
+	// hash of the sorted degree sequence
+	uint64_t degrees = 0;
+
+	[[nodiscard]] bool operator==(const fingerprint&) const noexcept = default;
+	[[nodiscard]] auto operator<=>(const fingerprint&) const noexcept = default;
+};
+
+/*
+ * Computation of fingerprints of trees.
+ *
+ * The AHU hash of a vertex combines the sorted hashes of its children. For
+ * free trees, vertices are rooted at the centre by peeling leaves layer by
+ * layer; when the tree has two centres, the hashes of both halves are
+ * combined in sorted order. All the memory is reused across calls.
+ */
+class fingerprinter {
+public:
+
+	template <class tree_t>
+	[[nodiscard]] fingerprint operator()(const tree_t& t) noexcept
+	{
+		static constexpr bool is_rooted =
+			std::is_same_v<lal::graphs::rooted_tree, tree_t>;
+
+		const uint64_t n = t.get_num_nodes();
+		m_hash.resize(n);
+		m_order.resize(n);
+		m_degree.resize(n);
+		m_level.resize(n);
+
+		fingerprint f;
+		if constexpr (is_rooted) {
+			f.ahu = rooted_hash(t);
+		}
+		else {
+			f.ahu = free_hash(t);
+		}
+
+		for (lal::node u = 0; u < n; ++u) {
+			m_degree[u] = t.get_degree(u);
+		}
+		std::sort(m_degree.begin(), m_degree.end());
+		f.degrees = combine(m_degree, 0x2545f4914f6cdd1d);
+		return f;
+	}
+
+private:
+
+	[[nodiscard]] static uint64_t mix(uint64_t x) noexcept
+	{
+		// splitmix64's finaliser
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111eb;
+		x ^= x >> 31;
+		return x;
+	}
+
+	// Hash of a sequence of values.
+	[[nodiscard]] static uint64_t
+	combine(const std::vector<uint64_t>& v, const uint64_t seed) noexcept
+	{
+		uint64_t h = seed ^ v.size();
+		for (const uint64_t x : v) {
+			h = mix(h ^ (x + 0x9e3779b97f4a7c15));
+		}
+		return mix(h);
+	}
+
+	// Hash of a vertex from the hashes of its children, taken from 'm_hash'.
+	template <class neighbors_t>
+	[[nodiscard]] uint64_t vertex_hash(const neighbors_t& children) noexcept
+	{
+		m_children.clear();
+		for (const lal::node v : children) {
+			m_children.push_back(m_hash[v]);
+		}
+		std::sort(m_children.begin(), m_children.end());
+		return combine(m_children, 0x5bd1e9955bd1e995);
+	}
+
+	template <class tree_t>
+	[[nodiscard]] uint64_t rooted_hash(const tree_t& t) noexcept
+	{
+		// BFS from the root; hashes are computed in reverse order
+		std::size_t tail = 0;
+		m_order[tail++] = t.get_root();
+		for (std::size_t head = 0; head < tail; ++head) {
+			for (const lal::node v : t.get_out_neighbors(m_order[head])) {
+				m_order[tail++] = v;
+			}
+		}
+		for (std::size_t i = tail; i-- > 0;) {
+			const lal::node u = m_order[i];
+			m_hash[u] = vertex_hash(t.get_out_neighbors(u));
+		}
+		return m_hash[t.get_root()];
+	}
+
+	template <class tree_t>
+	[[nodiscard]] uint64_t free_hash(const tree_t& t) noexcept
+	{
+		const uint64_t n = t.get_num_nodes();
+		if (n == 1) {
+			return combine({}, 0x5bd1e9955bd1e995);
+		}
+
+		// peel the leaves layer by layer until at most two vertices (the
+		// centres) remain; 'm_degree' holds the remaining degrees
+		std::size_t tail = 0;
+		for (lal::node u = 0; u < n; ++u) {
+			m_degree[u] = t.get_degree(u);
+			if (m_degree[u] == 1) {
+				m_order[tail++] = u;
+				m_level[u] = 0;
+			}
+		}
+		uint64_t remaining = n;
+		uint64_t level = 0;
+		std::size_t begin = 0;
+		while (remaining > 2) {
+			const std::size_t end = tail;
+			remaining -= end - begin;
+			++level;
+			for (; begin < end; ++begin) {
+				for (const lal::node v : t.get_neighbors(m_order[begin])) {
+					if (--m_degree[v] == 1) {
+						m_order[tail++] = v;
+						m_level[v] = level;
+					}
+				}
+			}
+		}
+
+		// the tree is rooted at the centres: the children of a vertex are
+		// its neighbours in lower levels, all of which precede it
+		for (std::size_t i = 0; i < n; ++i) {
+			const lal::node u = m_order[i];
+			m_children.clear();
+			for (const lal::node v : t.get_neighbors(u)) {
+				if (m_level[v] < m_level[u]) {
+					m_children.push_back(m_hash[v]);
+				}
+			}
+			std::sort(m_children.begin(), m_children.end());
+			m_hash[u] = combine(m_children, 0x5bd1e9955bd1e995);
+		}
+
+		if (n - begin == 1) {
+			return m_hash[m_order[n - 1]];
+		}
+		// two centres
+		const uint64_t h1 = m_hash[m_order[n - 2]];
+		const uint64_t h2 = m_hash[m_order[n - 1]];
+		m_children.assign({std::min(h1, h2), std::max(h1, h2)});
+		return combine(m_children, 0x6a09e667f3bcc909);
+	}
+
+	std::vector<uint64_t> m_hash;
+	std::vector<lal::node> m_order;
+	std::vector<uint64_t> m_degree;
+	std::vector<uint64_t> m_level;
+	std::vector<uint64_t> m_children;
+};
+
+} // namespace tree_isomorphism
+} // namespace profiling
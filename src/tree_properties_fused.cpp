@@ -0,0 +1,177 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "tree_properties_fused.hpp"
+
+// C++ includes
+#include <algorithm>
+
+namespace profiling {
+namespace properties_suite {
+
+namespace {
+
+// Keeps in (first, second) the two largest values seen, with x the new one.
+void push_top_two(uint64_t& first, uint64_t& second, const uint64_t x) noexcept
+{
+	if (x > first) {
+		second = first;
+		first = x;
+	}
+	else if (x > second) {
+		second = x;
+	}
+}
+
+} // namespace
+
+tree_properties fused_traversal::compute(const lal::graphs::free_tree& t)
+	noexcept
+{
+	const uint64_t n = t.get_num_nodes();
+	tree_properties res;
+	if (n <= 1) {
+		return res;
+	}
+
+	const bool mhd = m_selected.mean_hierarchical_distance;
+	const bool diameter = m_selected.diameter;
+	const bool caterpillar = m_selected.caterpillar_distance;
+	const bool branchless = m_selected.num_branchless_paths;
+	const bool subtree = m_selected.max_subtree_size;
+	const bool upward = diameter or caterpillar or subtree;
+
+	uint64_t num_hubs = 0;
+	if (not mhd and not upward) {
+		// only the branchless paths, which need no traversal
+		if (branchless) {
+			for (lal::node u = 0; u < n; ++u) {
+				num_hubs += t.get_degree(u) != 2;
+			}
+			res.num_branchless_paths = num_hubs - 1;
+		}
+		return res;
+	}
+
+	if (m_order.size() < n) {
+		m_order.resize(n);
+		m_parent.resize(n);
+		m_depth.resize(n);
+		m_size.resize(n);
+		m_height_1.resize(n);
+		m_height_2.resize(n);
+		m_weight_1.resize(n);
+		m_weight_2.resize(n);
+	}
+
+	// BFS from vertex 0
+	uint64_t sum_depths = 0;
+	std::size_t head = 0;
+	std::size_t tail = 0;
+	m_order[tail++] = 0;
+	m_parent[0] = n;
+	m_depth[0] = 0;
+	while (head < tail) {
+		const lal::node u = m_order[head++];
+		if (mhd) {
+			sum_depths += m_depth[u];
+		}
+		if (branchless) {
+			num_hubs += t.get_degree(u) != 2;
+		}
+		if (subtree) {
+			m_size[u] = 1;
+		}
+		if (diameter) {
+			m_height_1[u] = m_height_2[u] = 0;
+		}
+		if (caterpillar) {
+			m_weight_1[u] = m_weight_2[u] = 0;
+		}
+
+		for (const lal::node v : t.get_neighbors(u)) {
+			if (v != m_parent[u]) {
+				m_parent[v] = u;
+				m_depth[v] = m_depth[u] + 1;
+				m_order[tail++] = v;
+			}
+		}
+	}
+
+	// from the leaves up
+	uint64_t best_weight = 0;
+	if (upward) {
+		for (std::size_t i = n; i-- > 0;) {
+			const lal::node u = m_order[i];
+			const uint64_t w = t.get_degree(u) - 1;
+
+			if (diameter) {
+				res.diameter =
+					std::max(res.diameter, m_height_1[u] + m_height_2[u]);
+			}
+			if (caterpillar) {
+				best_weight =
+					std::max(best_weight, w + m_weight_1[u] + m_weight_2[u]);
+			}
+
+			if (u == 0) {
+				break;
+			}
+			const lal::node p = m_parent[u];
+			if (subtree) {
+				res.max_subtree_size =
+					std::max(res.max_subtree_size, m_size[u]);
+				m_size[p] += m_size[u];
+			}
+			if (diameter) {
+				push_top_two(m_height_1[p], m_height_2[p], m_height_1[u] + 1);
+			}
+			if (caterpillar) {
+				push_top_two(m_weight_1[p], m_weight_2[p], w + m_weight_1[u]);
+			}
+		}
+	}
+
+	if (mhd) {
+		res.mean_hierarchical_distance =
+			static_cast<double>(sum_depths) / static_cast<double>(n - 1);
+	}
+	if (caterpillar) {
+		// a caterpillar with spine P has sum_{u in P} (deg(u) - 1) + 2
+		// vertices
+		res.caterpillar_distance = n - (best_weight + 2);
+	}
+	if (branchless) {
+		// contracting the paths of vertices of degree 2 leaves a tree whose
+		// edges are the branchless paths
+		res.num_branchless_paths = num_hubs - 1;
+	}
+	return res;
+}
+
+} // namespace properties_suite
+} // namespace profiling
@@ -0,0 +1,110 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <vector>
+
+// lal includes
+#include <lal/basic_types.hpp>
+#include <lal/graphs/free_tree.hpp>
+
+namespace profiling {
+namespace properties_suite {
+
+// Properties of a free tree. Those that need a root use vertex 0.
+struct tree_properties {
+	// mean distance of the vertices to the root
+	double mean_hierarchical_distance = 0;
+	// number of edges of the longest path
+	uint64_t diameter = 0;
+	// number of vertices to remove to obtain a caterpillar
+	uint64_t caterpillar_distance = 0;
+	// number of maximal paths whose internal vertices have degree 2
+	uint64_t num_branchless_paths = 0;
+	// size of the largest subtree of a vertex other than the root
+	uint64_t max_subtree_size = 0;
+};
+
+// The properties of tree_properties to compute.
+struct property_selection {
+	bool mean_hierarchical_distance = false;
+	bool diameter = false;
+	bool caterpillar_distance = false;
+	bool num_branchless_paths = false;
+	bool max_subtree_size = false;
+};
+
+/*
+ * The selected properties in tree_properties computed in one traversal.
+ *
+ * A BFS from vertex 0 gives depths and the order of the vertices. Going
+ * through that order backwards, every vertex receives from its children
+ * their subtree sizes, their heights, and the largest weights of downward
+ * paths, where the weight of a vertex is its degree minus one. The diameter
+ * and the largest caterpillar are then the best two downward paths joined
+ * at some vertex. Only the work needed by the selected properties is done:
+ * the backward pass is skipped when no property needs it, and so is the BFS
+ * when only the branchless paths are selected. The properties that are not
+ * selected are left at 0. The buffers are kept across calls.
+ */
+class fused_traversal {
+public:
+
+	explicit fused_traversal(const property_selection& selected) noexcept
+		: m_selected(selected)
+	{ }
+
+	[[nodiscard]] tree_properties compute(const lal::graphs::free_tree& t)
+		noexcept;
+
+private:
+
+	// the properties to compute
+	const property_selection m_selected;
+
+	// vertices in BFS order from vertex 0
+	std::vector<lal::node> m_order;
+	// parent of every vertex in the BFS
+	std::vector<lal::node> m_parent;
+	// depth of every vertex
+	std::vector<uint64_t> m_depth;
+	// size of the subtree of every vertex
+	std::vector<uint64_t> m_size;
+	// two largest heights of the children of every vertex, plus one
+	std::vector<uint64_t> m_height_1;
+	std::vector<uint64_t> m_height_2;
+	// two largest weights of the downward paths from the children of every
+	// vertex
+	std::vector<uint64_t> m_weight_1;
+	std::vector<uint64_t> m_weight_2;
+};
+
+} // namespace properties_suite
+} // namespace profiling
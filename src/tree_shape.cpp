@@ -0,0 +1,101 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "tree_shape.hpp"
+
+// C++ includes
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace profiling {
+namespace generate {
+
+namespace {
+
+// Families whose parameter is a positive integer.
+[[nodiscard]] bool has_integer_parameter(const std::string& family) noexcept
+{
+	return family == "caterpillar" or family == "spider" or
+		   family == "kary" or family == "broom";
+}
+
+} // namespace
+
+bool parse_tree_shape(const std::string& str, tree_shape& shape) noexcept
+{
+	const std::size_t colon = str.find(':');
+	shape.family = str.substr(0, colon);
+	shape.parameter = 0;
+	if (colon != std::string::npos) {
+		shape.parameter = atof(str.c_str() + colon + 1);
+	}
+
+	if (shape.family == "random" or shape.family == "path" or
+		shape.family == "star") {
+		return colon == std::string::npos;
+	}
+	if (has_integer_parameter(shape.family)) {
+		return colon == std::string::npos or
+			   (shape.parameter >= 1 and
+				shape.parameter == std::floor(shape.parameter));
+	}
+	if (shape.family == "degree") {
+		return colon == std::string::npos or shape.parameter > 1;
+	}
+	return false;
+}
+
+void print_tree_shape_usage() noexcept
+{
+	// clang-format off
+	std::cout << "    [?]   -shape s\n";
+	std::cout << "          The shape of the trees, as 'family' or 'family:k':\n";
+	std::cout << "              random : uniformly random unlabelled trees.\n";
+	std::cout << "              path : a path.\n";
+	std::cout << "              star : a star.\n";
+	std::cout << "              caterpillar:k : a spine of k vertices, with the\n";
+	std::cout << "                  other vertices spread evenly over it as leaves.\n";
+	std::cout << "                  Default k: n/2.\n";
+	std::cout << "              spider:k : k legs of (almost) equal length joined\n";
+	std::cout << "                  at a centre. Default k: 3.\n";
+	std::cout << "              kary:k : complete k-ary tree. Default k: 2.\n";
+	std::cout << "              broom:k : a path of k vertices with the other\n";
+	std::cout << "                  vertices attached as leaves to one end.\n";
+	std::cout << "                  Default k: n/2.\n";
+	std::cout << "              degree:g : random trees whose degrees follow a\n";
+	std::cout << "                  power law of exponent g > 1. Default g: 2.5.\n";
+	std::cout << "          Rooted trees are rooted at vertex 0: an end of the path,\n";
+	std::cout << "          the spine and the broom, and the centre of the star and\n";
+	std::cout << "          the spider.\n";
+	std::cout << "          Default: random\n";
+	std::cout << '\n';
+	// clang-format on
+}
+
+} // namespace generate
+} // namespace profiling
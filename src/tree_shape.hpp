@@ -0,0 +1,53 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <string>
+
+namespace profiling {
+namespace generate {
+
+// The shape of the trees given to a profiler (option '-shape').
+struct tree_shape {
+	// random, path, star, caterpillar, spider, kary, broom or degree
+	std::string family = "random";
+	// parameter of the family; 0 means the default value
+	double parameter = 0;
+};
+
+// Parses a shape written as 'family' or 'family:parameter'. Returns false
+// if the family is unknown or the parameter is not valid for it.
+[[nodiscard]] bool
+parse_tree_shape(const std::string& str, tree_shape& shape) noexcept;
+
+// Prints the description of option '-shape' in the usage of a profiler.
+void print_tree_shape_usage() noexcept;
+
+} // namespace generate
+} // namespace profiling
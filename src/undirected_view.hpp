@@ -0,0 +1,225 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstddef>
+#include <cstdint>
+
+// lal includes
+#include <lal/basic_types.hpp>
+#include <lal/graphs/directed_graph.hpp>
+
+namespace profiling {
+namespace graphs {
+
+/*
+ * Non-owning undirected view of a directed graph (or a rooted tree).
+ *
+ * The neighbours of a vertex are its out-neighbours and its in-neighbours,
+ * merged while they are iterated. Two reciprocal edges (u,v) and (v,u) make
+ * v a single neighbour of u, like in the graph returned by to_undirected(),
+ * so the degree of a vertex is the number of distinct neighbours and every
+ * pair of reciprocal edges is one undirected edge. Building the view takes
+ * constant time: it allocates nothing and copies nothing. The reciprocal
+ * pairs are counted, in time linear in the size of the graph, the first time
+ * the number of edges is queried, so that call is not thread-safe.
+ *
+ * The graph must be normalised: both lists are then sorted, the merge skips
+ * the vertices present in both, and the neighbours are visited in
+ * increasing order.
+ *
+ * The view implements the part of the interface of
+ * lal::graphs::undirected_graph used to traverse a graph, so templated code
+ * accepts both. It must not outlive the graph, and it is invalidated when the
+ * graph is modified.
+ */
+class undirected_view {
+public:
+
+	// Neighbours of a vertex: the merge of two lists.
+	class neighbors_range {
+	public:
+
+		class iterator {
+		public:
+
+			iterator(
+				const lal::node *a,
+				const lal::node *a_end,
+				const lal::node *b,
+				const lal::node *b_end
+			) noexcept
+				: m_a(a),
+				  m_a_end(a_end),
+				  m_b(b),
+				  m_b_end(b_end)
+			{ }
+
+			[[nodiscard]] lal::node operator* () const noexcept
+			{
+				return take_a() ? *m_a : *m_b;
+			}
+
+			iterator& operator++ () noexcept
+			{
+				if (take_a()) {
+					// a vertex in both lists is skipped in both
+					if (m_b != m_b_end and *m_a == *m_b) {
+						++m_b;
+					}
+					++m_a;
+				}
+				else {
+					++m_b;
+				}
+				return *this;
+			}
+
+			[[nodiscard]] bool operator== (const iterator& it) const noexcept
+			{
+				return m_a == it.m_a and m_b == it.m_b;
+			}
+
+		private:
+
+			[[nodiscard]] bool take_a() const noexcept
+			{
+				return m_b == m_b_end or (m_a != m_a_end and *m_a <= *m_b);
+			}
+
+			const lal::node *m_a;
+			const lal::node *m_a_end;
+			const lal::node *m_b;
+			const lal::node *m_b_end;
+		};
+
+		neighbors_range(
+			const lal::neighbourhood& a, const lal::neighbourhood& b
+		) noexcept
+			: m_a(a),
+			  m_b(b)
+		{ }
+
+		[[nodiscard]] iterator begin() const noexcept
+		{
+			return iterator(
+				m_a.data(),
+				m_a.data() + m_a.size(),
+				m_b.data(),
+				m_b.data() + m_b.size()
+			);
+		}
+		[[nodiscard]] iterator end() const noexcept
+		{
+			const lal::node *a_end = m_a.data() + m_a.size();
+			const lal::node *b_end = m_b.data() + m_b.size();
+			return iterator(a_end, a_end, b_end, b_end);
+		}
+		// Number of distinct neighbours, in time linear in their number.
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return m_a.size() + m_b.size() - num_common();
+		}
+
+		// Number of vertices in both lists.
+		[[nodiscard]] std::size_t num_common() const noexcept
+		{
+			std::size_t common = 0;
+			std::size_t i = 0, j = 0;
+			while (i < m_a.size() and j < m_b.size()) {
+				if (m_a[i] < m_b[j]) {
+					++i;
+				}
+				else if (m_b[j] < m_a[i]) {
+					++j;
+				}
+				else {
+					++common;
+					++i;
+					++j;
+				}
+			}
+			return common;
+		}
+
+	private:
+
+		const lal::neighbourhood& m_a;
+		const lal::neighbourhood& m_b;
+	};
+
+	explicit undirected_view(const lal::graphs::directed_graph& g) noexcept
+		: m_g(g)
+	{ }
+
+	[[nodiscard]] uint64_t get_num_nodes() const noexcept
+	{
+		return m_g.get_num_nodes();
+	}
+	[[nodiscard]] uint64_t get_num_edges() const noexcept
+	{
+		if (not m_has_num_edges) {
+			// every pair of reciprocal edges is counted at both of its
+			// vertices
+			uint64_t common = 0;
+			for (lal::node u = 0; u < m_g.get_num_nodes(); ++u) {
+				common += get_neighbors(u).num_common();
+			}
+			m_num_edges = m_g.get_num_edges() - common / 2;
+			m_has_num_edges = true;
+		}
+		return m_num_edges;
+	}
+	[[nodiscard]] uint64_t get_degree(const lal::node u) const noexcept
+	{
+		return get_neighbors(u).size();
+	}
+	[[nodiscard]] bool
+	has_edge(const lal::node u, const lal::node v) const noexcept
+	{
+		return m_g.has_edge(u, v) or m_g.has_edge(v, u);
+	}
+	[[nodiscard]] neighbors_range
+	get_neighbors(const lal::node u) const noexcept
+	{
+		return neighbors_range(
+			m_g.get_out_neighbors(u), m_g.get_in_neighbors(u)
+		);
+	}
+
+private:
+
+	const lal::graphs::directed_graph& m_g;
+	// number of undirected edges, computed on the first query
+	mutable uint64_t m_num_edges = 0;
+	mutable bool m_has_num_edges = false;
+};
+
+} // namespace graphs
+} // namespace profiling
@@ -28,19 +28,29 @@
 // C++ includes
 #include <algorithm>
 #include <iostream>
+#include <numeric>
 #include <random>
 #include <string>
+#include <type_traits>
 
 // lal includes
 #include <lal/graphs/free_tree.hpp>
 #include <lal/graphs/rooted_tree.hpp>
 #include <lal/generate/all_ulab_free_trees.hpp>
 #include <lal/generate/all_ulab_rooted_trees.hpp>
+#include <lal/generate/rand_lab_free_trees.hpp>
+#include <lal/generate/rand_lab_rooted_trees.hpp>
+#include <lal/generate/rand_ulab_free_trees.hpp>
+#include <lal/generate/rand_ulab_rooted_trees.hpp>
 
 #include <lal/detail/macros/basic_convert.hpp>
 #include <lal/detail/utilities/tree_isomorphism.hpp>
 
+#include "generate_tree_shapes.hpp"
+#include "heap_memory.hpp"
 #include "time.hpp"
+#include "tree_fingerprint.hpp"
+#include "utilities_tree_isomorphism_pp.hpp"
 
 typedef lal::detail::isomorphism::algorithm algorithm;
 static constexpr auto string = lal::detail::isomorphism::algorithm::string;
@@ -51,61 +61,76 @@ static constexpr auto tuple_large =
 
 namespace profiling {
 
-void relabel_edges(
-	std::vector<lal::edge>& edges, lal::node& r, std::mt19937& gen
-) noexcept
-{
-	const uint64_t n = edges.size() + 1;
-
-	lal::detail::array<lal::node> relab(n);
-	std::iota(relab.begin(), relab.end(), 0);
-
-	std::shuffle(relab.begin(), relab.end(), gen);
-
-	// relabel each vertex accoring to 'relab'
-	for (lal::edge& e : edges) {
-		lal::node& s = e.first;
-		lal::node& t = e.second;
-		s = relab[s];
-		t = relab[t];
+// Buffers of one thread used to relabel trees. This is not an in-place
+// relabelling: LAL's graphs cannot permute their vertices in place, and
+// removing the edges of the previous relabelling one by one costs the sum of
+// the squared degrees. Therefore, the tree is rebuilt from scratch on every
+// relabelling with LAL's bulk operations, whose cost is linear in the number
+// of vertices whatever the shape of the tree. Only the permutation keeps its
+// memory from one relabelling to the next.
+template <class tree_t>
+struct relabelling_buffers {
+	std::vector<lal::node> relab;
+	tree_t tree;
+
+	// Sets 'tree' to a random relabelling of the tree with edges 'E'. For
+	// rooted trees, the root is the relabelling of 'r'. Returns the new label
+	// of vertex 0.
+	lal::node relabel(
+		const uint64_t n,
+		const std::vector<lal::edge>& E,
+		const lal::node r,
+		std::mt19937& gen
+	) noexcept
+	{
+		relab.resize(n);
+		std::iota(relab.begin(), relab.end(), 0);
+		std::shuffle(relab.begin(), relab.end(), gen);
+
+		tree.clear();
+		tree.init(n);
+		if constexpr (std::is_same_v<lal::graphs::rooted_tree, tree_t>) {
+			tree.set_root(relab[r]);
+		}
+		for (const auto& [u, v] : E) {
+			tree.add_edge_bulk(relab[u], relab[v]);
+		}
+		tree.finish_bulk_add(true, false);
+		return relab[0];
 	}
-	r = relab[r];
-}
+};
 
-void shuffle_tree(
-	const uint64_t n,
-	lal::node r,
-	std::vector<lal::edge>& edges,
-	lal::graphs::rooted_tree& T,
-	std::mt19937& gen
-) noexcept
+template <class tree_t>
+[[nodiscard]] lal::node root_of(const tree_t& t) noexcept
 {
-	relabel_edges(edges, r, gen);
-
-	T.clear();
-	T.init(n);
-	T.set_root(r);
-	T.set_edges(edges);
+	if constexpr (std::is_same_v<lal::graphs::rooted_tree, tree_t>) {
+		return t.get_root();
+	}
+	else {
+		return 0;
+	}
 }
 
-void shuffle_tree(
-	const uint64_t n,
-	std::vector<lal::edge>& edges,
-	lal::graphs::free_tree& T,
-	std::mt19937& gen
+// Throughput of the timed region and of the whole test, which also includes
+// generating and relabelling the trees. Every pair is tested at most once.
+void output_throughput(
+	const uint64_t n_calls, const double total_time, const double wall_time
 ) noexcept
 {
-	lal::node dummy = 0;
-	relabel_edges(edges, dummy, gen);
-	T.init(n);
-	T.set_edges(edges);
+	const double calls = lal::detail::to_double(n_calls);
+	std::cout << "Wall-clock time: " << time_to_str(wall_time) << '\n';
+	std::cout << "    Pairs/second (timed): " << calls / (total_time / 1000.0)
+			  << '\n';
+	std::cout << "    Pairs/second (wall-clock): "
+			  << calls / (wall_time / 1000.0) << '\n';
 }
 
 void output_info(
 	const uint64_t n,
 	const uint64_t N_relabs,
 	const uint64_t n_calls,
-	const double total_time
+	const double total_time,
+	const double wall_time
 ) noexcept
 {
 	std::cout << "Number of vertices: " << n << '\n';
@@ -117,22 +142,22 @@ void output_info(
 	std::cout << "    Time per call: "
 			  << time_to_str(total_time / lal::detail::to_double(n_calls))
 			  << '\n';
+	output_throughput(n_calls, total_time, wall_time);
 }
 
 // ground truth: ISOMORPHIC
 
 template <algorithm algo, class tree_t, class gen_t>
-void positive_exhaustive_test(
+double positive_exhaustive_test(
 	const uint64_t n, const uint64_t N, const uint64_t T, std::mt19937& gen
 )
 {
-	static constexpr bool is_rooted =
-		std::is_same_v<lal::graphs::rooted_tree, tree_t>;
+	const auto begin_wall = now();
 
 	uint64_t n_calls = 0;
 	double total_time = 0.0;
 
-	tree_t relab_tree;
+	relabelling_buffers<tree_t> B;
 	gen_t Gen(n);
 
 	std::size_t idx = 0;
@@ -140,21 +165,14 @@ void positive_exhaustive_test(
 		const tree_t cur_tree = Gen.get_tree();
 		Gen.next();
 
-		std::vector<lal::edge> edges_cur = cur_tree.get_edges();
+		const std::vector<lal::edge> edges_cur = cur_tree.get_edges();
 
 		for (uint64_t r = 0; r < N; ++r) {
-			if constexpr (is_rooted) {
-				shuffle_tree(
-					n, cur_tree.get_root(), edges_cur, relab_tree, gen
-				);
-			}
-			else {
-				shuffle_tree(n, edges_cur, relab_tree, gen);
-			}
+			B.relabel(n, edges_cur, root_of(cur_tree), gen);
 
 			const auto begin = now();
 			const bool res = lal::detail::are_trees_isomorphic<algo, true>(
-				cur_tree, relab_tree
+				cur_tree, B.tree
 			);
 			const auto end = now();
 			total_time += elapsed_time(begin, end);
@@ -169,18 +187,18 @@ void positive_exhaustive_test(
 		++idx;
 	}
 
-	output_info(n, N, n_calls, total_time);
+	output_info(n, N, n_calls, total_time, elapsed_time(begin_wall, now()));
+	return total_time;
 }
 
 // ground truth: NON-ISOMORPHIC
 
 template <algorithm algo, class tree_t, class gen_t>
-void negative_exhaustive_test(
+double negative_exhaustive_test(
 	const uint64_t n, const uint64_t N, const uint64_t T, std::mt19937& gen
 )
 {
-	static constexpr bool is_rooted =
-		std::is_same_v<lal::graphs::rooted_tree, tree_t>;
+	const auto begin_wall = now();
 
 	std::vector<tree_t> all_trees;
 	{
@@ -197,26 +215,21 @@ void negative_exhaustive_test(
 	uint64_t n_calls = 0;
 	double total_time = 0.0;
 
-	tree_t relab_tree;
+	relabelling_buffers<tree_t> B;
 	for (size_t i = 0; i < all_trees.size(); ++i) {
 		const tree_t& ti = all_trees[i];
 		for (size_t j = i + 1; j < all_trees.size(); ++j) {
 
 			const tree_t& tj = all_trees[j];
-			std::vector<lal::edge> edges_tj = tj.get_edges();
+			const std::vector<lal::edge> edges_tj = tj.get_edges();
 
 			for (uint64_t r = 0; r < N; ++r) {
 
-				if constexpr (is_rooted) {
-					shuffle_tree(n, ti.get_root(), edges_tj, relab_tree, gen);
-				}
-				else {
-					shuffle_tree(n, edges_tj, relab_tree, gen);
-				}
+				B.relabel(n, edges_tj, root_of(ti), gen);
 
 				const auto begin = now();
 				const bool res = lal::detail::are_trees_isomorphic<algo, true>(
-					ti, relab_tree
+					ti, B.tree
 				);
 				const auto end = now();
 				total_time += elapsed_time(begin, end);
@@ -231,132 +244,772 @@ void negative_exhaustive_test(
 		}
 	}
 
-	output_info(n, N, n_calls, total_time);
+	output_info(n, N, n_calls, total_time, elapsed_time(begin_wall, now()));
+	return total_time;
 }
 
-void utilities_tree_isomorphism(uint64_t argc, char *argv[]) noexcept
+void output_fingerprint_info(
+	const uint64_t n,
+	const uint64_t n_pairs,
+	const uint64_t n_calls,
+	const double fingerprint_time,
+	const double total_time,
+	const double wall_time
+) noexcept
 {
-	if (argc != 6) {
-		// clang-format off
-		std::cout << "    tree_type test_type num_vertices relabelings trees\n";
-		std::cout << '\n';
-		std::cout << "    algorithm:    string/tuple_small/tuple_large - the algorithm to profile\n";
-		std::cout << "    tree_type:    free/rooted - profile the test for free/rooted trees\n";
-		std::cout << "    test_type:    positive/negative - the answer of the test\n";
-		std::cout << "    num_vertices: number of vertices of the tree\n";
-		std::cout << "    relabelings:  number of times the vertices of a tree should be relabelled\n";
-		std::cout << "    trees:        number of trees to use\n";
-		std::cout << '\n';
-		// clang-format on
-		return;
-	}
+	std::cout << "Number of vertices: " << n << '\n';
+	std::cout << "Total pairs: " << n_pairs << '\n';
+	std::cout << "Pairs with equal fingerprints (calls): " << n_calls << '\n';
+	std::cout << "    Collision rate: "
+			  << lal::detail::to_double(n_calls) /
+					 lal::detail::to_double(n_pairs)
+			  << '\n';
+	std::cout << "Fingerprinting time: " << time_to_str(fingerprint_time)
+			  << '\n';
+	std::cout << "Isomorphism test time: " << time_to_str(total_time) << '\n';
+	std::cout << "Total time: " << time_to_str(fingerprint_time + total_time)
+			  << '\n';
+	std::cout << "    Time per pair: "
+			  << time_to_str(
+					 (fingerprint_time + total_time) /
+					 lal::detail::to_double(n_pairs)
+				 )
+			  << '\n';
+	output_throughput(n_pairs, fingerprint_time + total_time, wall_time);
+}
 
-	std::mt19937 gen(1234);
+// ground truth: ISOMORPHIC. Only pairs with equal fingerprints are tested.
 
-	const std::string algorithm(argv[0]);
-	const std::string tree_type(argv[1]);
-	const std::string test_type(argv[2]);
-	const uint64_t n = static_cast<uint64_t>(atoi(argv[3]));
-	const uint64_t r = static_cast<uint64_t>(atoi(argv[4]));
-	const uint64_t T = static_cast<uint64_t>(atoi(argv[5]));
+template <algorithm algo, class tree_t, class gen_t>
+double positive_fingerprint_test(
+	const uint64_t n, const uint64_t N, const uint64_t T, std::mt19937& gen
+)
+{
+	const auto begin_wall = now();
 
-	std::cout << "algorithm= " << algorithm << '\n';
-	std::cout << "tree_type= " << tree_type << '\n';
-	std::cout << "expected_answer= " << test_type << '\n';
-	std::cout << "n= " << n << '\n';
-	std::cout << "r= " << r << '\n';
-	std::cout << "T= " << T << '\n';
+	uint64_t n_pairs = 0;
+	uint64_t n_calls = 0;
+	double fingerprint_time = 0.0;
+	double total_time = 0.0;
 
-	if (algorithm == "string") {
-		if (tree_type == "free") {
-			if (test_type == "positive") {
-				positive_exhaustive_test<
-					string,
-					lal::graphs::free_tree,
-					lal::generate::all_ulab_free_trees>(n, r, T, gen);
-			}
-			else {
-				negative_exhaustive_test<
-					string,
-					lal::graphs::free_tree,
-					lal::generate::all_ulab_free_trees>(n, r, T, gen);
+	tree_isomorphism::fingerprinter F;
+	relabelling_buffers<tree_t> B;
+	gen_t Gen(n);
+
+	std::size_t idx = 0;
+	while (not Gen.end() and idx < T) {
+		const tree_t cur_tree = Gen.get_tree();
+		Gen.next();
+
+		const std::vector<lal::edge> edges_cur = cur_tree.get_edges();
+
+		const auto begin_cur = now();
+		const tree_isomorphism::fingerprint f_cur = F(cur_tree);
+		const auto end_cur = now();
+		fingerprint_time += elapsed_time(begin_cur, end_cur);
+
+		for (uint64_t r = 0; r < N; ++r) {
+			B.relabel(n, edges_cur, root_of(cur_tree), gen);
+
+			const auto begin = now();
+			const bool collide = F(B.tree) == f_cur;
+			const auto middle = now();
+			const bool res =
+				collide and lal::detail::are_trees_isomorphic<algo, true>(
+								cur_tree, B.tree
+							);
+			const auto end = now();
+			fingerprint_time += elapsed_time(begin, middle);
+			total_time += elapsed_time(middle, end);
+
+			if (not res) {
+				std::cerr << "ERROR!\n";
+				std::abort();
 			}
+			n_calls += collide;
 		}
-		else if (tree_type == "rooted") {
-			if (test_type == "positive") {
-				positive_exhaustive_test<
-					string,
-					lal::graphs::rooted_tree,
-					lal::generate::all_ulab_rooted_trees>(n, r, T, gen);
-			}
-			else {
-				negative_exhaustive_test<
-					string,
-					lal::graphs::rooted_tree,
-					lal::generate::all_ulab_rooted_trees>(n, r, T, gen);
-			}
+
+		n_pairs += N;
+		++idx;
+	}
+
+	output_fingerprint_info(
+		n,
+		n_pairs,
+		n_calls,
+		fingerprint_time,
+		total_time,
+		elapsed_time(begin_wall, now())
+	);
+	return fingerprint_time + total_time;
+}
+
+// ground truth: NON-ISOMORPHIC. Trees are bucketed by fingerprint, and only
+// pairs within the same bucket are tested.
+
+template <algorithm algo, class tree_t, class gen_t>
+double negative_fingerprint_test(
+	const uint64_t n, const uint64_t N, const uint64_t T, std::mt19937& gen
+)
+{
+	const auto begin_wall = now();
+
+	std::vector<tree_t> all_trees;
+	{
+		std::size_t idx = 0;
+		gen_t Gen(n);
+		while (not Gen.end() and idx < T) {
+			all_trees.push_back(Gen.get_tree());
+			Gen.next();
+			++idx;
 		}
+		std::cout << "idx= " << idx << '\n';
 	}
-	else if (algorithm == "tuple_small") {
-		if (tree_type == "free") {
-			if (test_type == "positive") {
-				positive_exhaustive_test<
-					tuple_small,
-					lal::graphs::free_tree,
-					lal::generate::all_ulab_free_trees>(n, r, T, gen);
+	const std::size_t num_trees = all_trees.size();
+
+	// fingerprint every tree once and sort the trees by fingerprint
+	std::vector<std::size_t> sorted(num_trees);
+	const auto begin_fp = now();
+	{
+		tree_isomorphism::fingerprinter F;
+		std::vector<tree_isomorphism::fingerprint> fps(num_trees);
+		for (std::size_t i = 0; i < num_trees; ++i) {
+			fps[i] = F(all_trees[i]);
+		}
+		std::iota(sorted.begin(), sorted.end(), 0);
+		std::stable_sort(
+			sorted.begin(),
+			sorted.end(),
+			[&](const std::size_t i, const std::size_t j)
+			{
+				return fps[i] < fps[j];
 			}
-			else {
-				negative_exhaustive_test<
-					tuple_small,
-					lal::graphs::free_tree,
-					lal::generate::all_ulab_free_trees>(n, r, T, gen);
+		);
+
+		// keep only the buckets with more than one tree, separated by
+		// num_trees
+		std::vector<std::size_t> buckets;
+		for (std::size_t b = 0; b < num_trees;) {
+			std::size_t e = b + 1;
+			while (e < num_trees and fps[sorted[e]] == fps[sorted[b]]) {
+				++e;
 			}
+			if (e - b > 1) {
+				buckets.insert(
+					buckets.end(), sorted.data() + b, sorted.data() + e
+				);
+				buckets.push_back(num_trees);
+			}
+			b = e;
+		}
+		sorted = std::move(buckets);
+	}
+	const auto end_fp = now();
+	const double fingerprint_time = elapsed_time(begin_fp, end_fp);
+
+	uint64_t n_calls = 0;
+	double total_time = 0.0;
+
+	relabelling_buffers<tree_t> B;
+	for (std::size_t b = 0; b < sorted.size(); ++b) {
+		const std::size_t i = sorted[b];
+		if (i == num_trees) {
+			continue;
 		}
-		else if (tree_type == "rooted") {
-			if (test_type == "positive") {
-				positive_exhaustive_test<
-					tuple_small,
-					lal::graphs::rooted_tree,
-					lal::generate::all_ulab_rooted_trees>(n, r, T, gen);
+		const tree_t& ti = all_trees[i];
+		for (std::size_t c = b + 1; sorted[c] != num_trees; ++c) {
+
+			const tree_t& tj = all_trees[sorted[c]];
+			const std::vector<lal::edge> edges_tj = tj.get_edges();
+
+			for (uint64_t r = 0; r < N; ++r) {
+
+				B.relabel(n, edges_tj, root_of(ti), gen);
+
+				const auto begin = now();
+				const bool res = lal::detail::are_trees_isomorphic<algo, true>(
+					ti, B.tree
+				);
+				const auto end = now();
+				total_time += elapsed_time(begin, end);
+
+				if (res) {
+					std::cerr << "ERROR!\n";
+					std::abort();
+				}
 			}
-			else {
-				negative_exhaustive_test<
-					tuple_small,
-					lal::graphs::rooted_tree,
-					lal::generate::all_ulab_rooted_trees>(n, r, T, gen);
+
+			n_calls += N;
+		}
+	}
+
+	const uint64_t n_pairs = N * (num_trees * (num_trees - 1) / 2);
+	output_fingerprint_info(
+		n,
+		n_pairs,
+		n_calls,
+		fingerprint_time,
+		total_time,
+		elapsed_time(begin_wall, now())
+	);
+	return fingerprint_time + total_time;
+}
+
+// Result of a parallel test.
+struct parallel_result {
+	// number of calls to the isomorphism test
+	uint64_t n_calls = 0;
+	// sum of the new labels of vertex 0 over all relabellings
+	uint64_t checksum = 0;
+	// number of wrong answers
+	uint64_t n_errors = 0;
+};
+
+// ground truth: ISOMORPHIC. Every tree is a task.
+
+template <algorithm algo, class tree_t>
+parallel_result positive_parallel_test(
+	const std::vector<tree_t>& trees,
+	const std::vector<std::vector<lal::edge>>& edges,
+	const uint64_t N,
+	const uint64_t seed,
+	const uint64_t num_threads
+) noexcept
+{
+	const uint64_t n = trees[0].get_num_nodes();
+	uint64_t n_calls = 0;
+	uint64_t checksum = 0;
+	uint64_t n_errors = 0;
+
+#pragma omp parallel num_threads(static_cast<int>(num_threads))
+	{
+		relabelling_buffers<tree_t> B;
+
+#pragma omp for schedule(dynamic, 1) reduction(+ : n_calls, checksum, n_errors)
+		for (uint64_t t = 0; t < trees.size(); ++t) {
+			std::seed_seq seq{seed, t};
+			std::mt19937 gen(seq);
+
+			for (uint64_t r = 0; r < N; ++r) {
+				checksum += B.relabel(n, edges[t], root_of(trees[t]), gen);
+				if (not lal::detail::are_trees_isomorphic<algo, true>(
+						trees[t], B.tree
+					)) {
+					++n_errors;
+				}
 			}
+			n_calls += N;
 		}
 	}
-	else if (algorithm == "tuple_large") {
-		if (tree_type == "free") {
-			if (test_type == "positive") {
-				positive_exhaustive_test<
-					tuple_large,
-					lal::graphs::free_tree,
-					lal::generate::all_ulab_free_trees>(n, r, T, gen);
+
+	return {n_calls, checksum, n_errors};
+}
+
+// ground truth: NON-ISOMORPHIC. The pairs (i,j), i < j, are split into
+// blocks of consecutive pairs, and every block is a task.
+
+template <algorithm algo, class tree_t>
+parallel_result negative_parallel_test(
+	const std::vector<tree_t>& trees,
+	const std::vector<std::vector<lal::edge>>& edges,
+	const uint64_t N,
+	const uint64_t seed,
+	const uint64_t block_size,
+	const uint64_t num_threads
+) noexcept
+{
+	const uint64_t n = trees[0].get_num_nodes();
+	const uint64_t T = trees.size();
+	const uint64_t num_pairs = T * (T - 1) / 2;
+	const uint64_t num_blocks = (num_pairs + block_size - 1) / block_size;
+
+	// index of the first pair of every row i
+	std::vector<uint64_t> row_start(T);
+	for (uint64_t i = 0; i < T; ++i) {
+		row_start[i] = i * (2 * T - i - 1) / 2;
+	}
+
+	uint64_t n_calls = 0;
+	uint64_t checksum = 0;
+	uint64_t n_errors = 0;
+
+#pragma omp parallel num_threads(static_cast<int>(num_threads))
+	{
+		relabelling_buffers<tree_t> B;
+
+#pragma omp for schedule(dynamic, 1) reduction(+ : n_calls, checksum, n_errors)
+		for (uint64_t b = 0; b < num_blocks; ++b) {
+			std::seed_seq seq{seed, b};
+			std::mt19937 gen(seq);
+
+			uint64_t k = b * block_size;
+			const uint64_t k_end = std::min(k + block_size, num_pairs);
+
+			// first pair of the block
+			uint64_t i = static_cast<uint64_t>(
+				std::upper_bound(row_start.begin(), row_start.end(), k) -
+				row_start.begin() - 1
+			);
+			uint64_t j = i + 1 + (k - row_start[i]);
+
+			for (; k < k_end; ++k) {
+				for (uint64_t r = 0; r < N; ++r) {
+					checksum +=
+						B.relabel(n, edges[j], root_of(trees[i]), gen);
+					if (lal::detail::are_trees_isomorphic<algo, true>(
+							trees[i], B.tree
+						)) {
+						++n_errors;
+					}
+				}
+				n_calls += N;
+
+				if (++j == T) {
+					++i;
+					j = i + 1;
+				}
 			}
-			else {
-				negative_exhaustive_test<
-					tuple_large,
-					lal::graphs::free_tree,
-					lal::generate::all_ulab_free_trees>(n, r, T, gen);
+		}
+	}
+
+	return {n_calls, checksum, n_errors};
+}
+
+template <algorithm algo, class tree_t, class gen_t>
+void parallel_test(const tree_isomorphism::tree_isomorphism_pp& parser)
+{
+	const uint64_t n = parser.get_n();
+	const uint64_t N = parser.get_r();
+	const uint64_t max_threads = parser.get_threads();
+	const bool positive = parser.get_test() == "positive";
+
+	std::vector<tree_t> trees;
+	std::vector<std::vector<lal::edge>> edges;
+	{
+		gen_t Gen(n);
+		while (not Gen.end() and trees.size() < parser.get_T()) {
+			trees.push_back(Gen.get_tree());
+			edges.push_back(trees.back().get_edges());
+			Gen.next();
+		}
+		std::cout << "idx= " << trees.size() << '\n';
+	}
+	if (trees.empty()) {
+		return;
+	}
+
+	std::cout << "Number of vertices: " << n << '\n';
+
+	double base_time = 0.0;
+	uint64_t base_checksum = 0;
+	for (uint64_t t = 1;; t = std::min(2 * t, max_threads)) {
+		const auto begin = now();
+		const parallel_result res =
+			positive ? positive_parallel_test<algo>(
+						   trees, edges, N, parser.get_seed(), t
+					   )
+					 : negative_parallel_test<algo>(
+						   trees,
+						   edges,
+						   N,
+						   parser.get_seed(),
+						   parser.get_block_size(),
+						   t
+					   );
+		const auto end = now();
+		const double total_time = elapsed_time(begin, end);
+
+		if (t == 1) {
+			base_time = total_time;
+			base_checksum = res.checksum;
+		}
+
+		std::cout << "------------------------\n";
+		std::cout << "Threads: " << t << '\n';
+		std::cout << "    Total calls: " << res.n_calls << '\n';
+		std::cout << "    Total time: " << time_to_str(total_time) << '\n';
+		std::cout << "    Calls/second: "
+				  << lal::detail::to_double(res.n_calls) /
+						 (total_time / 1000.0)
+				  << '\n';
+		std::cout << "    Speedup: " << base_time / total_time << '\n';
+		std::cout << "    Checksum: " << res.checksum << '\n';
+
+		if (res.n_errors > 0) {
+			std::cerr << "ERROR! " << res.n_errors << " wrong answers.\n";
+			std::abort();
+		}
+		if (res.checksum != base_checksum) {
+			std::cerr << "ERROR! The relabellings differ from those made with "
+						 "one thread.\n";
+			std::abort();
+		}
+
+		if (t == max_threads) {
+			break;
+		}
+	}
+}
+
+// Moves a random leaf of the tree with edges 'edges' to another vertex so
+// that the degree sequence is preserved. The result may still be isomorphic
+// to the original tree, which the caller has to check. For rooted trees, 'r'
+// is the root, which is never moved; for free trees, 'r' is n. Returns false
+// if no such move was found.
+template <class tree_t>
+[[nodiscard]] bool move_leaf(
+	const uint64_t n,
+	std::vector<lal::edge>& edges,
+	const lal::node r,
+	std::vector<uint64_t>& degree,
+	std::vector<lal::node>& candidates,
+	std::mt19937& gen
+) noexcept
+{
+	static constexpr uint64_t max_attempts = 100;
+
+	degree.assign(n, 0);
+	for (const auto& [u, v] : edges) {
+		++degree[u];
+		++degree[v];
+	}
+
+	std::uniform_int_distribution<std::size_t> E(0, edges.size() - 1);
+
+	for (uint64_t a = 0; a < max_attempts; ++a) {
+		const std::size_t e = E(gen);
+		const auto [u, v] = edges[e];
+
+		// in rooted trees edges are oriented from parent to child, so only
+		// the second vertex can be a leaf
+		lal::node leaf, parent;
+		if (degree[v] == 1 and v != r) {
+			leaf = v;
+			parent = u;
+		}
+		else if (not std::is_same_v<lal::graphs::rooted_tree, tree_t> and
+				 degree[u] == 1) {
+			leaf = u;
+			parent = v;
+		}
+		else {
+			continue;
+		}
+
+		// the degree of 'parent' decreases and the degree of 'q' increases:
+		// the sequence is the same only when deg(q) + 1 = deg(parent)
+		candidates.clear();
+		for (lal::node q = 0; q < n; ++q) {
+			if (q != leaf and q != parent and degree[q] + 1 == degree[parent]) {
+				candidates.push_back(q);
 			}
 		}
-		else if (tree_type == "rooted") {
-			if (test_type == "positive") {
-				positive_exhaustive_test<
-					tuple_large,
-					lal::graphs::rooted_tree,
-					lal::generate::all_ulab_rooted_trees>(n, r, T, gen);
+		if (candidates.empty()) {
+			continue;
+		}
+
+		std::uniform_int_distribution<std::size_t> C(0, candidates.size() - 1);
+		edges[e] = {candidates[C(gen)], leaf};
+		return true;
+	}
+	return false;
+}
+
+// The generator of the trees of a random source or of source 'shape'.
+template <class gen_t>
+[[nodiscard]] gen_t
+make_generator(const tree_isomorphism::tree_isomorphism_pp& parser)
+{
+	if constexpr (std::is_constructible_v<
+					  gen_t,
+					  uint64_t,
+					  const generate::tree_shape&,
+					  uint64_t>) {
+		return gen_t(parser.get_n(), parser.get_shape(), parser.get_seed());
+	}
+	else {
+		return gen_t(parser.get_n(), parser.get_seed());
+	}
+}
+
+// Random trees. Every tree is tested against N relabelled copies of itself
+// (positive) or N relabelled copies of itself with one leaf moved
+// (negative). Negative pairs are kept only when the fingerprints of the two
+// trees differ. The time and heap memory of every call are measured.
+
+template <algorithm algo, class tree_t, class gen_t>
+void random_test(const tree_isomorphism::tree_isomorphism_pp& parser)
+{
+	static constexpr bool is_rooted =
+		std::is_same_v<lal::graphs::rooted_tree, tree_t>;
+
+	const uint64_t n = parser.get_n();
+	const uint64_t N = parser.get_r();
+	const uint64_t T = parser.get_T();
+	const bool positive = parser.get_test() == "positive";
+
+	if (not positive and n < 4) {
+		std::cout << "Error: negative pairs need trees of at least 4 "
+					 "vertices.\n";
+		return;
+	}
+
+	const auto begin_wall = now();
+
+	gen_t Gen = make_generator<gen_t>(parser);
+	std::mt19937 gen(parser.get_seed());
+
+	relabelling_buffers<tree_t> B;
+	std::vector<lal::edge> edges;
+	std::vector<uint64_t> degree;
+	std::vector<lal::node> candidates;
+	tree_isomorphism::fingerprinter F;
+	tree_isomorphism::fingerprint f_cur;
+
+	uint64_t n_calls = 0;
+	uint64_t n_skipped = 0;
+	double total_time = 0.0;
+	uint64_t total_allocations = 0;
+	uint64_t total_bytes = 0;
+	double total_peak = 0.0;
+	int64_t max_peak = 0;
+
+	for (uint64_t t = 0; t < T; ++t) {
+		const tree_t cur_tree = Gen.get_tree();
+		const lal::node r = root_of(cur_tree);
+		if (not positive) {
+			f_cur = F(cur_tree);
+		}
+
+		for (uint64_t k = 0; k < N; ++k) {
+			edges = cur_tree.get_edges();
+			const lal::node fixed = is_rooted ? r : n;
+			if (not positive and
+				not move_leaf<tree_t>(
+					n, edges, fixed, degree, candidates, gen
+				)) {
+				++n_skipped;
+				continue;
+			}
+			B.relabel(n, edges, r, gen);
+
+			// equal fingerprints: the trees may be isomorphic
+			if (not positive and F(B.tree) == f_cur) {
+				++n_skipped;
+				continue;
 			}
-			else {
-				negative_exhaustive_test<
-					tuple_large,
-					lal::graphs::rooted_tree,
-					lal::generate::all_ulab_rooted_trees>(n, r, T, gen);
+
+			heap_memory::start_counting();
+			const auto begin = now();
+			const bool res = lal::detail::are_trees_isomorphic<algo, true>(
+				cur_tree, B.tree
+			);
+			const auto end = now();
+			const heap_memory::counters c = heap_memory::stop_counting();
+
+			if (res != positive) {
+				std::cerr << "ERROR!\n";
+				std::abort();
 			}
+
+			++n_calls;
+			total_time += elapsed_time(begin, end);
+			total_allocations += c.allocations;
+			total_bytes += c.bytes;
+			total_peak += lal::detail::to_double(c.peak);
+			max_peak = std::max(max_peak, c.peak);
+		}
+	}
+
+	const double calls = lal::detail::to_double(n_calls);
+	std::cout << "Number of vertices: " << n << '\n';
+	std::cout << "Total calls: " << n_calls << '\n';
+	if (n_skipped > 0) {
+		std::cout << "Skipped pairs (no non-isomorphic move found): "
+				  << n_skipped << '\n';
+	}
+	if (n_calls == 0) {
+		return;
+	}
+	std::cout << "Total time: " << time_to_str(total_time) << '\n';
+	std::cout << "    Time per call: " << time_to_str(total_time / calls)
+			  << '\n';
+	output_throughput(n_calls, total_time, elapsed_time(begin_wall, now()));
+	if (not heap_memory::enabled) {
+		std::cout << "Heap memory: not measured (configure with "
+					 "-DENABLE_HEAP_MEMORY=ON)\n";
+		return;
+	}
+	std::cout << "Heap memory per call:\n";
+	std::cout << "    Allocations: "
+			  << lal::detail::to_double(total_allocations) / calls << '\n';
+	std::cout << "    Bytes allocated: "
+			  << lal::detail::to_double(total_bytes) / calls << '\n';
+	std::cout << "    Peak bytes (average): " << total_peak / calls << '\n';
+	std::cout << "    Peak bytes (maximum): " << max_peak << '\n';
+}
+
+template <algorithm algo, class tree_t, class gen_t>
+void run_test(
+	const tree_isomorphism::tree_isomorphism_pp& parser, std::mt19937& gen
+)
+{
+	const uint64_t n = parser.get_n();
+	const uint64_t r = parser.get_r();
+	const uint64_t T = parser.get_T();
+	const bool positive = parser.get_test() == "positive";
+	const std::string& mode = parser.get_mode();
+
+	if (parser.get_source() != "exhaustive") {
+		random_test<algo, tree_t, gen_t>(parser);
+		return;
+	}
+	if (parser.has_threads()) {
+		parallel_test<algo, tree_t, gen_t>(parser);
+		return;
+	}
+
+	double direct_time = 0.0;
+	double fingerprint_time = 0.0;
+
+	if (mode == "direct" or mode == "compare") {
+		if (mode == "compare") {
+			std::cout << "------------------------\n";
+			std::cout << "Direct\n";
+		}
+		if (positive) {
+			direct_time =
+				positive_exhaustive_test<algo, tree_t, gen_t>(n, r, T, gen);
+		}
+		else {
+			direct_time =
+				negative_exhaustive_test<algo, tree_t, gen_t>(n, r, T, gen);
+		}
+	}
+	if (mode == "fingerprint" or mode == "compare") {
+		if (mode == "compare") {
+			std::cout << "------------------------\n";
+			std::cout << "Fingerprint\n";
+		}
+		if (positive) {
+			fingerprint_time =
+				positive_fingerprint_test<algo, tree_t, gen_t>(n, r, T, gen);
+		}
+		else {
+			fingerprint_time =
+				negative_fingerprint_test<algo, tree_t, gen_t>(n, r, T, gen);
 		}
 	}
+	if (mode == "compare") {
+		std::cout << "------------------------\n";
+		std::cout << "Speedup: " << direct_time / fingerprint_time << '\n';
+	}
+}
+
+template <algorithm algo>
+void run_test(
+	const tree_isomorphism::tree_isomorphism_pp& parser, std::mt19937& gen
+)
+{
+	const std::string& source = parser.get_source();
+	const bool is_free = parser.get_tree_type() == "free";
+
+	if (source == "rand_lab") {
+		if (is_free) {
+			run_test<
+				algo,
+				lal::graphs::free_tree,
+				lal::generate::rand_lab_free_trees>(parser, gen);
+		}
+		else {
+			run_test<
+				algo,
+				lal::graphs::rooted_tree,
+				lal::generate::rand_lab_rooted_trees>(parser, gen);
+		}
+	}
+	else if (source == "rand_ulab") {
+		if (is_free) {
+			run_test<
+				algo,
+				lal::graphs::free_tree,
+				lal::generate::rand_ulab_free_trees>(parser, gen);
+		}
+		else {
+			run_test<
+				algo,
+				lal::graphs::rooted_tree,
+				lal::generate::rand_ulab_rooted_trees>(parser, gen);
+		}
+	}
+	else if (source == "shape") {
+		// trees of a shape are tested as random trees
+		if (is_free) {
+			random_test<
+				algo,
+				lal::graphs::free_tree,
+				generate::tree_shape_generator<lal::graphs::free_tree>>(parser);
+		}
+		else {
+			random_test<
+				algo,
+				lal::graphs::rooted_tree,
+				generate::tree_shape_generator<lal::graphs::rooted_tree>>(
+				parser
+			);
+		}
+	}
+	else if (is_free) {
+		run_test<
+			algo,
+			lal::graphs::free_tree,
+			lal::generate::all_ulab_free_trees>(parser, gen);
+	}
+	else {
+		run_test<
+			algo,
+			lal::graphs::rooted_tree,
+			lal::generate::all_ulab_rooted_trees>(parser, gen);
+	}
+}
+
+void utilities_tree_isomorphism(uint64_t argc, char *argv[]) noexcept
+{
+	tree_isomorphism::tree_isomorphism_pp parser(argc, argv);
+	{
+		if (parser.parse_params() > 0) {
+			return;
+		}
+		if (parser.check_errors() > 0) {
+			return;
+		}
+	}
+
+	std::mt19937 gen(1234);
+
+	const std::string& algorithm = parser.get_algorithm();
+
+	std::cout << "algorithm= " << algorithm << '\n';
+	std::cout << "tree_type= " << parser.get_tree_type() << '\n';
+	std::cout << "expected_answer= " << parser.get_test() << '\n';
+	std::cout << "n= " << parser.get_n() << '\n';
+	std::cout << "r= " << parser.get_r() << '\n';
+	std::cout << "T= " << parser.get_T() << '\n';
+	std::cout << "mode= " << parser.get_mode() << '\n';
+	std::cout << "source= " << parser.get_source() << '\n';
+	if (parser.get_source() == "shape") {
+		std::cout << "shape= " << parser.get_shape().family << '\n';
+	}
+
+	if (algorithm == "string") {
+		run_test<string>(parser, gen);
+	}
+	else if (algorithm == "tuple_small") {
+		run_test<tuple_small>(parser, gen);
+	}
+	else if (algorithm == "tuple_large") {
+		run_test<tuple_large>(parser, gen);
+	}
 }
 
 } // namespace profiling
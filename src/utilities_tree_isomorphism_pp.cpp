@@ -0,0 +1,268 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#include "utilities_tree_isomorphism_pp.hpp"
+
+// C++ includes
+#include <cstdlib>
+#include <iostream>
+
+namespace profiling {
+namespace tree_isomorphism {
+
+tree_isomorphism_pp::tree_isomorphism_pp(uint64_t argc, char *argv[]) noexcept
+	: m_argc(argc),
+	  m_argv(argv)
+{ }
+
+void tree_isomorphism_pp::print_usage() const noexcept
+{
+	// clang-format off
+	std::cout << "Profiling -- Tree isomorphism test\n";
+	std::cout << "==================================\n";
+	std::cout << '\n';
+	std::cout << "This program's options are the following:\n";
+	std::cout << "    Those marked with [*] are mandatory for all execution modes.\n";
+	std::cout << "    Those marked with [i] are mandatory for execution mode i.\n";
+	std::cout << "    Those marked with [?] are optional.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -algorithm A\n";
+	std::cout << "          The algorithm to profile:\n";
+	for (const std::string& algo : m_allowed_algorithms) {
+	std::cout << "              " << algo << '\n';
+	}
+	std::cout << '\n';
+	std::cout << "    [*]   -tree-type t\n";
+	std::cout << "          Profile the test for free/rooted trees.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -test t\n";
+	std::cout << "          The answer of the test: positive/negative.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -source s\n";
+	std::cout << "          Where trees come from:\n";
+	std::cout << "          [1] exhaustive: all unlabelled trees of n vertices. Every\n";
+	std::cout << "              pair of different trees is a negative pair.\n";
+	std::cout << "          [2] rand_lab, rand_ulab: uniformly random labelled or\n";
+	std::cout << "              unlabelled trees. Negative pairs are made by moving a\n";
+	std::cout << "              leaf so that the degree sequence is preserved; pairs\n";
+	std::cout << "              that turn out to be isomorphic are skipped. Time and\n";
+	std::cout << "              heap memory are reported per call; heap memory\n";
+	std::cout << "              only in builds configured with\n";
+	std::cout << "              -DENABLE_HEAP_MEMORY=ON.\n";
+	std::cout << "          [3] shape: trees of the shape given with -shape, tested\n";
+	std::cout << "              as those of the random sources.\n";
+	std::cout << "          Default: exhaustive\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -n n\n";
+	std::cout << "          Number of vertices of the trees.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -r r\n";
+	std::cout << "          Number of times the vertices of a tree are relabelled.\n";
+	std::cout << '\n';
+	std::cout << "    [*]   -T T\n";
+	std::cout << "          Number of trees to use. With random sources, every tree\n";
+	std::cout << "          is tested against r relabelled (positive) or modified\n";
+	std::cout << "          (negative) copies of itself.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -mode m\n";
+	std::cout << "          How pairs of trees are tested:\n";
+	std::cout << "          [1] direct: every pair goes to the isomorphism test.\n";
+	std::cout << "          [2] fingerprint: a fingerprint of every tree is computed\n";
+	std::cout << "              once, and only pairs with equal fingerprints go to\n";
+	std::cout << "              the isomorphism test.\n";
+	std::cout << "          [3] compare: run both and report the speedup.\n";
+	std::cout << "          Default: direct\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -threads P\n";
+	std::cout << "          Run the direct test in parallel with 1, 2, 4, ..., P\n";
+	std::cout << "          threads and report the speedup. Every task has its own\n";
+	std::cout << "          random generator, seeded from the master seed and the\n";
+	std::cout << "          task, so results do not depend on the number of threads.\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -seed s\n";
+	std::cout << "          Master seed of the parallel test.\n";
+	std::cout << "          Default: 1234\n";
+	std::cout << '\n';
+	std::cout << "    [?]   -block b\n";
+	std::cout << "          Number of pairs of trees per task in the parallel\n";
+	std::cout << "          negative test. In the positive test, every tree is a task.\n";
+	std::cout << "          Default: 64\n";
+	std::cout << '\n';
+	generate::print_tree_shape_usage();
+	// clang-format on
+}
+
+int tree_isomorphism_pp::parse_params() noexcept
+{
+	if (m_argc == 0) {
+		print_usage();
+		return 1;
+	}
+
+	for (uint64_t i = 0; i < m_argc; ++i) {
+		const std::string param(m_argv[i]);
+
+		if (param == "--help" or param == "-h") {
+			print_usage();
+			return 1;
+		}
+		else if (param == "-algorithm") {
+			m_algorithm = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-tree-type") {
+			m_tree_type = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-test") {
+			m_test = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-mode") {
+			m_mode = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-threads") {
+			m_threads = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			m_has_threads = true;
+			++i;
+		}
+		else if (param == "-seed") {
+			m_seed = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			++i;
+		}
+		else if (param == "-block") {
+			m_block_size = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			++i;
+		}
+		else if (param == "-source") {
+			m_source = std::string(m_argv[i + 1]);
+			++i;
+		}
+		else if (param == "-n") {
+			m_n = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			m_has_n = true;
+			++i;
+		}
+		else if (param == "-r") {
+			m_r = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			m_has_r = true;
+			++i;
+		}
+		else if (param == "-T") {
+			m_T = static_cast<uint64_t>(atoll(m_argv[i + 1]));
+			m_has_T = true;
+			++i;
+		}
+		else if (param == "-shape") {
+			if (not generate::parse_tree_shape(m_argv[i + 1], m_shape)) {
+				std::cerr << "Error: wrong value for parameter '-shape'.\n";
+				std::cerr << "    Value: '" << m_argv[i + 1] << "'\n";
+				return 2;
+			}
+			++i;
+		}
+		else {
+			std::cerr << "Error: unrecognised option\n";
+			std::cerr << "    " << param << '\n';
+			return 2;
+		}
+	}
+	return 0;
+}
+
+int tree_isomorphism_pp::check_errors() const noexcept
+{
+	if (m_algorithm == "none") {
+		std::cout << "Error: missing parameter '-algorithm'.\n";
+		return 1;
+	}
+	if (not m_allowed_algorithms.contains(m_algorithm)) {
+		std::cout << "Error: wrong algorithm '" << m_algorithm << "'.\n";
+		return 1;
+	}
+	if (m_tree_type == "none") {
+		std::cout << "Error: missing parameter '-tree-type'.\n";
+		return 1;
+	}
+	if (not m_allowed_tree_types.contains(m_tree_type)) {
+		std::cout << "Error: wrong tree type '" << m_tree_type << "'.\n";
+		return 1;
+	}
+	if (m_test == "none") {
+		std::cout << "Error: missing parameter '-test'.\n";
+		return 1;
+	}
+	if (not m_allowed_tests.contains(m_test)) {
+		std::cout << "Error: wrong test '" << m_test << "'.\n";
+		return 1;
+	}
+	if (not m_allowed_modes.contains(m_mode)) {
+		std::cout << "Error: wrong mode '" << m_mode << "'.\n";
+		return 1;
+	}
+	if (not m_allowed_sources.contains(m_source)) {
+		std::cout << "Error: wrong source '" << m_source << "'.\n";
+		return 1;
+	}
+	if (m_source != "exhaustive" and (m_mode != "direct" or m_has_threads)) {
+		std::cout << "Error: random sources are only valid in mode 'direct'\n";
+		std::cout << "    and without -threads.\n";
+		return 1;
+	}
+	if (m_has_threads) {
+		if (m_threads == 0) {
+			std::cout << "Error: the number of threads must be positive.\n";
+			return 1;
+		}
+		if (m_mode != "direct") {
+			std::cout << "Error: option -threads is only valid in mode\n";
+			std::cout << "    'direct'.\n";
+			return 1;
+		}
+	}
+	if (m_block_size == 0) {
+		std::cout << "Error: the block size must be positive.\n";
+		return 1;
+	}
+	if (not m_has_n) {
+		std::cout << "Error: missing parameter '-n'.\n";
+		return 1;
+	}
+	if (not m_has_r) {
+		std::cout << "Error: missing parameter '-r'.\n";
+		return 1;
+	}
+	if (not m_has_T) {
+		std::cout << "Error: missing parameter '-T'.\n";
+		return 1;
+	}
+	return 0;
+}
+
+} // namespace tree_isomorphism
+} // namespace profiling
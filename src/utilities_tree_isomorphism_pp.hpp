@@ -0,0 +1,170 @@
+/***********************************************************************
+ *
+ * Profiling programs for LAL
+ * Copyright (C) 2019 - 2026 Lluís Alemany Puig
+ *
+ * The full code is available at:
+ *     https://github.com/LAL-project/profiling.git
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Contact:
+ *
+ *    Lluís Alemany Puig (lluis.alemany.puig@upc.edu)
+ *
+ ***********************************************************************/
+
+#pragma once
+
+// C++ includes
+#include <cstdint>
+#include <string>
+#include <set>
+
+// common includes
+#include "tree_shape.hpp"
+
+namespace profiling {
+namespace tree_isomorphism {
+
+class tree_isomorphism_pp {
+public:
+
+	tree_isomorphism_pp(uint64_t argc, char *argv[]) noexcept;
+	~tree_isomorphism_pp() noexcept = default;
+
+	[[nodiscard]] const std::string& get_algorithm() const noexcept
+	{
+		return m_algorithm;
+	}
+	[[nodiscard]] const std::string& get_tree_type() const noexcept
+	{
+		return m_tree_type;
+	}
+	[[nodiscard]] const std::string& get_test() const noexcept
+	{
+		return m_test;
+	}
+	[[nodiscard]] const std::string& get_mode() const noexcept
+	{
+		return m_mode;
+	}
+	[[nodiscard]] const std::string& get_source() const noexcept
+	{
+		return m_source;
+	}
+	[[nodiscard]] uint64_t get_n() const noexcept
+	{
+		return m_n;
+	}
+	[[nodiscard]] uint64_t get_r() const noexcept
+	{
+		return m_r;
+	}
+	[[nodiscard]] uint64_t get_T() const noexcept
+	{
+		return m_T;
+	}
+	[[nodiscard]] bool has_threads() const noexcept
+	{
+		return m_has_threads;
+	}
+	[[nodiscard]] uint64_t get_threads() const noexcept
+	{
+		return m_threads;
+	}
+	[[nodiscard]] uint64_t get_seed() const noexcept
+	{
+		return m_seed;
+	}
+	[[nodiscard]] uint64_t get_block_size() const noexcept
+	{
+		return m_block_size;
+	}
+	[[nodiscard]] const generate::tree_shape& get_shape() const noexcept
+	{
+		return m_shape;
+	}
+
+	void print_usage() const noexcept;
+
+	// returns 0 on success,
+	// returns 1 on help,
+	// returns 2 on error
+	[[nodiscard]] int parse_params() noexcept;
+
+	// returns 0 if there are no errors.
+	// returns 1 if there are errors.
+	[[nodiscard]] int check_errors() const noexcept;
+
+private:
+
+	// isomorphism algorithm
+	std::string m_algorithm = "none";
+
+	// type of tree
+	std::string m_tree_type = "none";
+
+	// expected answer of the test
+	std::string m_test = "none";
+
+	// how pairs of trees are tested
+	std::string m_mode = "direct";
+
+	// where trees come from
+	std::string m_source = "exhaustive";
+
+	// number of vertices
+	uint64_t m_n = 0;
+	bool m_has_n = false;
+
+	// number of relabellings of every tree
+	uint64_t m_r = 0;
+	bool m_has_r = false;
+
+	// number of trees
+	uint64_t m_T = 0;
+	bool m_has_T = false;
+
+	// maximum number of threads of the parallel driver
+	uint64_t m_threads = 1;
+	bool m_has_threads = false;
+
+	// master seed of the parallel driver
+	uint64_t m_seed = 1234;
+
+	// number of pairs of trees per task of the parallel driver
+	uint64_t m_block_size = 64;
+
+	const std::set<std::string> m_allowed_algorithms =
+		std::set<std::string>({"string", "tuple_small", "tuple_large"});
+	const std::set<std::string> m_allowed_tree_types =
+		std::set<std::string>({"free", "rooted"});
+	const std::set<std::string> m_allowed_tests =
+		std::set<std::string>({"positive", "negative"});
+	const std::set<std::string> m_allowed_sources =
+		std::set<std::string>({"exhaustive", "rand_lab", "rand_ulab", "shape"}
+		);
+	const std::set<std::string> m_allowed_modes =
+		std::set<std::string>({"direct", "fingerprint", "compare"});
+
+	// shape of the trees
+	generate::tree_shape m_shape;
+
+	uint64_t m_argc;
+	char **m_argv;
+};
+
+} // namespace tree_isomorphism
+} // namespace profiling